@@ -0,0 +1,152 @@
+// LED output stage benchmark: the per-side path (as HourGlass::applyLedSide
+// and LedMagnetController::sendLED did it: per-channel gamma lookup, float
+// luminosity scaling and clamping, then field-by-field change checks on one
+// object per side) against LedFrame::process() over every side at once,
+// reading the combined gamma + luminosity LedOutputTable.
+// Each tick a fraction of the sides changes colour, like a running effect.
+// GCC only vectorizes the column kernels at -O3 (the openFrameworks release
+// setting on Linux); clang does at -O2.
+//
+//   make -C bench CXXFLAGS="-O3 -std=c++17 -Wall" && ./bench/led_frame_bench [ticks]
+
+#include "LedFrame.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::shared_ptr<const LedOutputTable> table = LedOutputTable::build(2.2f, 3);
+const uint8_t * gammaLUT = table->gamma;
+
+// Per-side state as it was spread over LedMagnetController and HourGlass::LedSideState
+struct Side {
+	uint8_t r = 0, g = 0, b = 0, mainLed = 0, pwm = 0;
+	int blend = 0, origin = 0, arc = 360;
+	float luminosity = 1.0f;
+
+	uint8_t outR = 0, outG = 0, outB = 0, outMainLed = 0;
+	int outBlend = 0, outOrigin = 0, outArc = 0;
+	bool rgbInitialized = false, mainLedInitialized = false;
+
+	uint8_t sentR = 0, sentG = 0, sentB = 0;
+	int sentOrigin = -1, sentArc = -1, sentMainLed = -1, sentPwm = -1;
+	float sentLuminosity = -1.0f;
+};
+
+uint8_t scaled(uint8_t value, float global, float individual) {
+	return static_cast<uint8_t>(std::min(std::max(static_cast<float>(value) * global * individual, 0.0f), 255.0f));
+}
+
+// Returns the number of OSC messages the tick would send
+size_t tickPerSide(std::vector<Side> & sides, float global) {
+	size_t messages = 0;
+	for (Side & side : sides) {
+		uint8_t r = scaled(gammaLUT[side.r], global, side.luminosity);
+		uint8_t g = scaled(gammaLUT[side.g], global, side.luminosity);
+		uint8_t b = scaled(gammaLUT[side.b], global, side.luminosity);
+		int blend = std::min(std::max(side.blend, 0), 768);
+		int origin = std::min(std::max(side.origin, 0), 360);
+		int arc = std::min(std::max(side.arc, 0), 360);
+		if (!side.rgbInitialized || r != side.outR || g != side.outG || b != side.outB || blend != side.outBlend || origin != side.outOrigin || arc != side.outArc) {
+			side.outR = r;
+			side.outG = g;
+			side.outB = b;
+			side.outBlend = blend;
+			side.outOrigin = origin;
+			side.outArc = arc;
+			side.rgbInitialized = true;
+		}
+		uint8_t mainLed = scaled(side.mainLed, global, side.luminosity);
+		if (!side.mainLedInitialized || mainLed != side.outMainLed) {
+			side.outMainLed = mainLed;
+			side.mainLedInitialized = true;
+		}
+
+		if (side.r != side.sentR || side.g != side.sentG || side.b != side.sentB || side.origin != side.sentOrigin || side.arc != side.sentArc || side.luminosity != side.sentLuminosity) {
+			side.sentR = side.r;
+			side.sentG = side.g;
+			side.sentB = side.b;
+			side.sentOrigin = side.origin;
+			side.sentArc = side.arc;
+			side.sentLuminosity = side.luminosity;
+			messages++;
+		}
+		if (side.mainLed != side.sentMainLed) {
+			side.sentMainLed = side.mainLed;
+			messages++;
+		}
+		if (side.pwm != side.sentPwm) {
+			side.sentPwm = side.pwm;
+			messages++;
+		}
+	}
+	return messages;
+}
+
+size_t tickFrame(LedFrame & frame, float global) {
+	frame.process(*table, global);
+	size_t messages = 0;
+	for (size_t slot = 0; slot < frame.size(); slot++) {
+		uint8_t changes = frame.getChanges(slot);
+		if (changes == 0) continue;
+		messages += (changes & 1) + ((changes >> 1) & 1) + ((changes >> 2) & 1);
+		frame.commit(slot);
+	}
+	return messages;
+}
+
+// Side i changes colour on tick t when (i + t) % 8 == 0
+uint8_t colourAt(size_t side, int tick) {
+	return static_cast<uint8_t>(((side + tick) / 8) * 37);
+}
+
+double run(size_t sides, int ticks, bool soa, size_t & messages) {
+	std::vector<Side> perSide(sides);
+	LedFrame frame;
+	frame.reset(sides);
+	messages = 0;
+	double total = 0.0;
+	for (int t = 0; t < ticks; t++) {
+		// Staging (effects output) is the same work either way and not timed
+		for (size_t i = 0; i < sides; i++) {
+			uint8_t c = colourAt(i, t);
+			if (soa) {
+				frame.stage(i, c, 255 - c, c / 2, 384, 0, 360, 0.8f, 128, 0, false);
+			} else {
+				Side & side = perSide[i];
+				side.r = c;
+				side.g = 255 - c;
+				side.b = c / 2;
+				side.blend = 384;
+				side.mainLed = 128;
+				side.luminosity = 0.8f;
+			}
+		}
+		auto start = Clock::now();
+		messages += soa ? tickFrame(frame, 0.9f) : tickPerSide(perSide, 0.9f);
+		total += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	}
+	return total / ticks;
+}
+
+}
+
+int main(int argc, char ** argv) {
+	int ticks = argc > 1 ? std::atoi(argv[1]) : 2000;
+	std::printf("%8s %14s %14s %10s %10s\n", "sides", "per-side ns", "frame ns", "ns/side", "messages");
+	for (size_t sides : { 8, 32, 128, 512, 2048 }) {
+		size_t perSideMessages = 0;
+		size_t frameMessages = 0;
+		double perSide = run(sides, ticks, false, perSideMessages);
+		double frame = run(sides, ticks, true, frameMessages);
+		std::printf("%8zu %14.0f %14.0f %10.2f %10zu%s\n", sides, perSide, frame, frame / sides, frameMessages,
+			perSideMessages == frameMessages ? "" : "  (message count differs)");
+	}
+	return 0;
+}
@@ -0,0 +1,226 @@
+// Motor repeat cadence benchmark: the legacy deque scan (as
+// OSCOutController::repeatWorker did it) against RepeatScheduler, each driven
+// by the same I/O thread loop as OSCEgressService. A producer enqueues bursts
+// of repeats the way /system/motor/rotate to every hourglass does. Every
+// firing records how far its spacing from the previous send drifts from the
+// configured delay (jitter), and how far it is from the ideal schedule
+// first send + k * delay (drift).
+//
+//   make -C bench && ./bench/repeat_jitter_bench [motors-per-burst] [bursts]
+
+#include "RepeatScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// OSCOutController::MOTOR_SEND_REPEATS / MOTOR_REPEAT_DELAY_MS
+constexpr int SEND_REPEATS = 3;
+constexpr auto REPEAT_DELAY = std::chrono::milliseconds(10);
+constexpr auto BURST_PERIOD = std::chrono::microseconds(16667); // one 60 Hz tick
+constexpr auto REPEAT_HORIZON = std::chrono::microseconds(200); // OSCEgressService::REPEAT_HORIZON
+constexpr auto SEND_COST = std::chrono::microseconds(2); // stand-in for one sendto()
+
+struct Results {
+	std::vector<double> jitter; // |gap to previous send - delay|, us
+	std::vector<double> drift; // |send time - ideal time|, us
+};
+
+// Copied into the send list by the heap queue, so the timing it updates is shared
+struct Sample {
+	struct Track {
+		Clock::time_point last; // previous send of this entry
+		Clock::time_point ideal; // first send + k * delay
+		Results * results;
+	};
+	std::shared_ptr<Track> track;
+};
+
+double micros(Clock::duration d) {
+	return std::chrono::duration<double, std::micro>(d).count();
+}
+
+void fakeSend(Sample & sample) {
+	auto start = Clock::now();
+	while (Clock::now() - start < SEND_COST) {
+	}
+	auto now = Clock::now();
+	Sample::Track & track = *sample.track;
+	track.ideal += REPEAT_DELAY;
+	track.results->jitter.push_back(std::abs(micros(now - track.last) - micros(REPEAT_DELAY)));
+	track.results->drift.push_back(std::abs(micros(now - track.ideal)));
+	track.last = now;
+}
+
+void report(const char * name, const char * metric, std::vector<double> & values) {
+	std::sort(values.begin(), values.end());
+	double sum = 0.0;
+	for (double v : values) sum += v;
+	auto percentile = [&values](double p) { return values[std::min(values.size() - 1, static_cast<size_t>(p * values.size()))]; };
+	std::printf("%-6s %-9s %7zu repeats  mean %8.1f us  p50 %8.1f us  p99 %8.1f us  max %8.1f us\n",
+		name, metric, values.size(), sum / values.size(), percentile(0.50), percentile(0.99), values.back());
+}
+
+// Legacy: scan for the earliest entry, then scan again to send
+class LegacyQueue {
+public:
+	struct Pending {
+		Sample sample;
+		int remaining;
+		Clock::time_point nextDue;
+	};
+
+	void push(Sample sample, int count) {
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.push_back(Pending { sample, count, Clock::now() + REPEAT_DELAY });
+		cv.notify_all();
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (running) {
+			if (queue.empty()) {
+				cv.wait(lock, [this] { return !running || !queue.empty(); });
+				continue;
+			}
+			auto earliest = queue.front().nextDue;
+			for (const auto & pending : queue) {
+				earliest = std::min(earliest, pending.nextDue);
+			}
+			auto now = Clock::now();
+			if (earliest > now) {
+				cv.wait_until(lock, earliest);
+				continue;
+			}
+			for (auto it = queue.begin(); it != queue.end();) {
+				if (it->nextDue <= now) {
+					fakeSend(it->sample);
+					if (--it->remaining <= 0) {
+						it = queue.erase(it);
+						continue;
+					}
+					it->nextDue = now + REPEAT_DELAY;
+				}
+				++it;
+			}
+		}
+	}
+
+	void stop() {
+		std::lock_guard<std::mutex> lock(mutex);
+		running = false;
+		cv.notify_all();
+	}
+	bool idle() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return queue.empty();
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::deque<Pending> queue;
+	bool running = true;
+};
+
+// Same loop as OSCEgressService::run(): due sends are collected under the
+// lock and made after releasing it
+class HeapQueue {
+public:
+	void push(Sample sample, int count) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto due = Clock::now() + REPEAT_DELAY;
+		bool earliest = scheduler.empty() || due < scheduler.nextDue();
+		scheduler.push(sample, count, REPEAT_DELAY, due);
+		if (earliest) cv.notify_all();
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (running) {
+			if (scheduler.empty()) {
+				cv.wait(lock, [this] { return !running || !scheduler.empty(); });
+				continue;
+			}
+			auto now = Clock::now();
+			if (scheduler.nextDue() > now + REPEAT_HORIZON) {
+				cv.wait_until(lock, scheduler.nextDue() - REPEAT_HORIZON);
+				continue;
+			}
+			scheduler.runDue(now, REPEAT_HORIZON, [this](Sample & sample, Clock::time_point) { due.push_back(sample); });
+			lock.unlock();
+			for (Sample & sample : due) fakeSend(sample);
+			due.clear();
+			lock.lock();
+		}
+	}
+
+	void stop() {
+		std::lock_guard<std::mutex> lock(mutex);
+		running = false;
+		cv.notify_all();
+	}
+	bool idle() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return scheduler.empty();
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable cv;
+	RepeatScheduler<Sample> scheduler;
+	std::vector<Sample> due; // sent after releasing the lock
+	bool running = true;
+};
+
+template <typename Queue>
+void measure(const char * name, int motorsPerBurst, int bursts) {
+	Queue queue;
+	Results results;
+	results.jitter.reserve(static_cast<size_t>(motorsPerBurst) * bursts * SEND_REPEATS);
+	results.drift.reserve(static_cast<size_t>(motorsPerBurst) * bursts * SEND_REPEATS);
+	std::thread worker([&queue] { queue.run(); });
+
+	auto start = Clock::now();
+	for (int burst = 0; burst < bursts; burst++) {
+		std::this_thread::sleep_until(start + BURST_PERIOD * burst);
+		for (int motor = 0; motor < motorsPerBurst; motor++) {
+			// The first send goes out on the frame thread; the rest are repeats
+			auto now = Clock::now();
+			queue.push(Sample { std::make_shared<Sample::Track>(Sample::Track { now, now, &results }) }, SEND_REPEATS - 1);
+		}
+	}
+	while (!queue.idle()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	queue.stop();
+	worker.join();
+
+	report(name, "jitter", results.jitter);
+	report(name, "drift", results.drift);
+}
+
+}
+
+int main(int argc, char ** argv) {
+	int motorsPerBurst = std::max(1, argc > 1 ? std::atoi(argv[1]) : 200);
+	int bursts = std::max(1, argc > 2 ? std::atoi(argv[2]) : 60);
+	std::printf("%d bursts of %d motors, %d sends each, %lld ms apart, ~%lld us per send\n",
+		bursts, motorsPerBurst, SEND_REPEATS, static_cast<long long>(REPEAT_DELAY.count()),
+		static_cast<long long>(SEND_COST.count()));
+
+	measure<LegacyQueue>("deque", motorsPerBurst, bursts);
+	measure<HeapQueue>("heap", motorsPerBurst, bursts);
+	return 0;
+}
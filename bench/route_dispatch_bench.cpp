@@ -0,0 +1,198 @@
+// Incoming OSC dispatch microbenchmark: the legacy split + string-compare chain
+// (as OSCController::processMessage did it) against OSCAddress + OSCRouteTable.
+// Only address routing is measured; both sides end in the same handler stubs.
+//
+//   make -C bench && ./bench/route_dispatch_bench [iterations]
+
+#include "OSCAddress.h"
+#include "OSCRouteTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum Route { BLACKOUT, NOOP, MOTOR, LED, HG_BLACKOUT, HG_LUMINOSITY, SYS_LUMINOSITY, SYS_MESSAGE,
+	SYS_PRESET, SYS_CONFIG, SYS_ROTATE, SYS_POSITION, SYS_ZERO, ERROR, ROUTE_COUNT };
+
+unsigned long long hits[ROUTE_COUNT];
+
+// ofSplitString(address, "/", true)
+std::vector<std::string> legacySplit(const std::string & source) {
+	std::vector<std::string> result;
+	std::size_t pos = 0;
+	while (pos <= source.size()) {
+		std::size_t next = source.find('/', pos);
+		if (next == std::string::npos) next = source.size();
+		std::string part = source.substr(pos, next - pos);
+		if (!part.empty()) result.push_back(part);
+		pos = next + 1;
+	}
+	return result;
+}
+
+void legacyDispatch(const std::string & address) {
+	std::vector<std::string> addressParts = legacySplit(address);
+	if (addressParts.empty()) {
+		hits[ERROR]++;
+		return;
+	}
+	if (address == "/blackout") {
+		hits[BLACKOUT]++;
+		return;
+	}
+	if (addressParts[0] == "hourglass") {
+		if (addressParts.size() >= 2 && (addressParts[1] == "connect" || addressParts[1] == "disconnect" || addressParts[1] == "status")) {
+			hits[NOOP]++;
+		} else if (addressParts.size() >= 3) {
+			if (addressParts[2] == "motor") {
+				hits[MOTOR]++;
+			} else if (addressParts[2] == "led" || addressParts[2] == "pwm" || addressParts[2] == "dotstar" || addressParts[2] == "main" || addressParts[2] == "up" || addressParts[2] == "down") {
+				hits[LED]++;
+			} else if (addressParts[2] == "connect" || addressParts[2] == "disconnect" || addressParts[2] == "status") {
+				hits[NOOP]++;
+			} else if (addressParts[2] == "blackout") {
+				hits[HG_BLACKOUT]++;
+			} else if (addressParts[2] == "luminosity") {
+				hits[HG_LUMINOSITY]++;
+			} else {
+				hits[ERROR]++;
+			}
+		} else {
+			hits[ERROR]++;
+		}
+	} else if (addressParts[0] == "system") {
+		if (addressParts.size() >= 2) {
+			if (addressParts[1] == "luminosity") {
+				hits[SYS_LUMINOSITY]++;
+			} else if (addressParts[1] == "list_devices" || addressParts[1] == "emergency_stop_all") {
+				hits[SYS_MESSAGE]++;
+			} else if (addressParts.size() >= 3 && addressParts[1] == "motor" && addressParts[2] == "preset") {
+				hits[SYS_PRESET]++;
+			} else if (addressParts.size() >= 5 && addressParts[1] == "motor" && addressParts[2] == "config") {
+				hits[SYS_CONFIG]++;
+			} else if (addressParts.size() >= 4 && addressParts[1] == "motor" && addressParts[2] == "rotate") {
+				hits[SYS_ROTATE]++;
+			} else if (addressParts.size() >= 4 && addressParts[1] == "motor" && addressParts[2] == "position") {
+				hits[SYS_POSITION]++;
+			} else if (addressParts.size() >= 3 && addressParts[1] == "motor" && addressParts[2] == "set_zero_all") {
+				hits[SYS_ZERO]++;
+			} else {
+				hits[ERROR]++;
+			}
+		} else {
+			hits[ERROR]++;
+		}
+	} else {
+		hits[ERROR]++;
+	}
+}
+
+// Same table as OSCController::buildRoutes()
+OSCRouteTable<Route> buildRoutes() {
+	OSCRouteTable<Route> routes;
+	routes.add("/blackout", BLACKOUT);
+	for (const char * command : { "connect", "disconnect", "status" }) {
+		routes.add(std::string("/hourglass/") + command + "/**", NOOP);
+		routes.add(std::string("/hourglass/*/") + command + "/**", NOOP);
+	}
+	routes.add("/hourglass/*/motor/**", MOTOR);
+	for (const char * target : { "led", "pwm", "dotstar", "main", "up", "down" }) {
+		routes.add(std::string("/hourglass/*/") + target + "/**", LED);
+	}
+	routes.add("/hourglass/*/blackout/**", HG_BLACKOUT);
+	routes.add("/hourglass/*/luminosity/**", HG_LUMINOSITY);
+	routes.add("/system/luminosity/**", SYS_LUMINOSITY);
+	routes.add("/system/list_devices/**", SYS_MESSAGE);
+	routes.add("/system/emergency_stop_all/**", SYS_MESSAGE);
+	routes.add("/system/motor/preset/**", SYS_PRESET);
+	routes.add("/system/motor/config/*/*/**", SYS_CONFIG);
+	routes.add("/system/motor/rotate/*/**", SYS_ROTATE);
+	routes.add("/system/motor/position/*/**", SYS_POSITION);
+	routes.add("/system/motor/set_zero_all/**", SYS_ZERO);
+	return routes;
+}
+
+void routeDispatch(const OSCRouteTable<Route> & routes, const std::string & address) {
+	OSCAddress addressParts;
+	if (!addressParts.parse(address) || addressParts.empty()) {
+		hits[ERROR]++;
+		return;
+	}
+	const Route * route = routes.find(addressParts);
+	hits[route ? *route : ERROR]++;
+}
+
+// Sequencer-style traffic for a 40 hourglass installation
+std::vector<std::string> buildTraffic() {
+	static const char * kCommands[] = { "up/rgb", "down/rgb", "led/all/arc", "led/all/blend", "up/origin",
+		"pwm/all", "main/up", "luminosity", "motor/rotate", "motor/speed" };
+	std::vector<std::string> traffic;
+	for (int id = 1; id <= 40; id++) {
+		for (const char * command : kCommands) {
+			traffic.push_back("/hourglass/" + std::to_string(id) + "/" + command);
+		}
+	}
+	traffic.push_back("/hourglass/1-20/led/all/rgb");
+	traffic.push_back("/hourglass/all/up/blend");
+	traffic.push_back("/system/luminosity");
+	traffic.push_back("/system/motor/rotate/90");
+	traffic.push_back("/blackout");
+	return traffic;
+}
+
+template <typename F>
+double messagesPerSecond(const std::vector<std::string> & traffic, int iterations, F dispatch) {
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++) {
+		for (const std::string & address : traffic) dispatch(address);
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return double(traffic.size()) * iterations / elapsed.count();
+}
+
+unsigned long long totalHits() {
+	unsigned long long total = 0;
+	for (unsigned long long h : hits) total += h;
+	return total;
+}
+
+} // namespace
+
+int main(int argc, char ** argv) {
+	int iterations = argc > 1 ? std::atoi(argv[1]) : 2000;
+	std::vector<std::string> traffic = buildTraffic();
+	OSCRouteTable<Route> routes = buildRoutes();
+
+	// Both dispatchers must agree on every address before timing anything
+	std::vector<std::string> checked = traffic;
+	for (const char * edge : { "/", "/foo/bar", "/hourglass", "/hourglass/1", "/hourglass/connect", "/hourglass/2/status/x",
+			 "/hourglass/1/bogus/x", "//hourglass//3//up//rgb", "/system", "/system/motor", "/system/motor/config/100",
+			 "/system/motor/config/100/50", "/system/motor/rotate", "/system/motor/set_zero_all", "/blackout/extra" }) {
+		checked.push_back(edge);
+	}
+	for (const std::string & address : checked) {
+		std::fill(std::begin(hits), std::end(hits), 0ULL);
+		legacyDispatch(address);
+		std::vector<unsigned long long> expected(std::begin(hits), std::end(hits));
+		std::fill(std::begin(hits), std::end(hits), 0ULL);
+		routeDispatch(routes, address);
+		if (!std::equal(expected.begin(), expected.end(), std::begin(hits))) {
+			std::fprintf(stderr, "route mismatch for %s\n", address.c_str());
+			return 1;
+		}
+	}
+
+	std::fill(std::begin(hits), std::end(hits), 0ULL);
+	double legacy = messagesPerSecond(traffic, iterations, legacyDispatch);
+	double routed = messagesPerSecond(traffic, iterations, [&routes](const std::string & address) { routeDispatch(routes, address); });
+
+	std::printf("%zu addresses x %d iterations (%llu dispatches)\n", traffic.size(), iterations, totalHits());
+	std::printf("legacy split + compare : %12.0f msg/s\n", legacy);
+	std::printf("route table            : %12.0f msg/s\n", routed);
+	std::printf("speedup                : %12.2fx\n", routed / legacy);
+	return 0;
+}
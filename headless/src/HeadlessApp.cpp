@@ -0,0 +1,76 @@
+#include "HeadlessApp.h"
+
+void HeadlessApp::setup() {
+	ofSetFrameRate(settings.tickRate);
+
+	hourglassManager.loadConfiguration("hourglasses.json");
+	hourglassManager.connectAll();
+
+	// Sequencer playback goes through the same pipeline as network OSC
+	vezerPlayer.setMessageSink([this](ofxOscMessage & msg) {
+		oscController.processMessage(msg);
+	});
+	if (!settings.sequencePath.empty()) {
+		if (vezerPlayer.load(ofToDataPath(settings.sequencePath, true))) {
+			vezerPlayer.setLoop(true);
+			vezerPlayer.play();
+		} else {
+			ofLogError("HeadlessApp") << "Could not load sequence " << settings.sequencePath;
+		}
+	}
+
+	oscController.setup(settings.receivePort);
+	oscController.setEnabled(true);
+	if (!settings.recordPath.empty()) oscController.startCapture(settings.recordPath);
+	if (!settings.replayPath.empty()) oscController.startReplay(settings.replayPath, !settings.replayFast);
+
+	ofLogNotice("HeadlessApp") << hourglassManager.getHourGlassCount() << " hourglasses, OSC in on "
+							   << settings.receivePort << ", " << settings.tickRate << " Hz";
+}
+
+void HeadlessApp::update() {
+	float dt = ofGetLastFrameTime();
+
+	oscController.update();
+	vezerPlayer.update(dt);
+	oscController.commitStagedParameters();
+	hourglassManager.update(dt);
+	OSCEgressService::instance().flushPackets();
+	ticks++;
+
+	float now = ofGetElapsedTimef();
+	if (settings.statsInterval > 0.0f && now - lastStatsTime >= settings.statsInterval) {
+		logStats();
+		lastStatsTime = now;
+	}
+	if (settings.runSeconds > 0.0f && now >= settings.runSeconds) {
+		ofExit();
+	}
+}
+
+void HeadlessApp::exit() {
+	logStats();
+	oscController.shutdown();
+	hourglassManager.disconnectAll();
+}
+
+void HeadlessApp::logStats() {
+	OSCController::IngestStats ingest = oscController.getIngestStats();
+	OSCEgressService::Stats egress = OSCEgressService::instance().getStats();
+	OSCEgressService::AckStats acks = OSCEgressService::instance().getAckStats();
+	const OSCBundleScheduler::Stats & bundles = oscController.getBundleScheduler().getStats();
+	ofLogNotice("HeadlessApp") << "ticks " << ticks << " (" << ofToString(ofGetFrameRate(), 1) << " Hz)"
+							   << ", osc received " << ingest.received << " dropped " << ingest.dropped
+							   << " malformed " << ingest.malformed << " handler errors " << ingest.handlerErrors
+							   << ", max queue delay " << ingest.maxQueueDelayMicros << " us"
+							   << ", bundles pending " << oscController.getBundleScheduler().size()
+							   << " applied " << bundles.applied << " expired " << bundles.expired
+							   << " lateness last/max/mean abs " << bundles.lastLatenessMicros << "/" << bundles.maxLatenessMicros
+							   << "/" << ofToString(bundles.meanAbsLatenessMicros, 1) << " us"
+							   << ", osc errors " << oscController.getErrorLog().getStats().reported
+							   << ", egress " << egress.lastTickDatagrams << " datagrams in " << egress.lastTickSyscalls
+							   << " syscalls last tick (" << (egress.batched ? "sendmmsg" : "per datagram") << ")"
+							   << ", motor acks " << acks.acked << "/" << acks.sent << " in flight " << acks.inFlight
+							   << " retransmits " << acks.retransmits << " expired " << acks.expired
+							   << " rtt " << ofToString(acks.smoothedRttMs, 2) << " ms";
+}
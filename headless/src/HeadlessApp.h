@@ -0,0 +1,43 @@
+#pragma once
+
+#include "HourGlassManager.h"
+#include "OSCEgressService.h"
+#include "OSCController.h"
+#include "VezerPlayer.h"
+#include "ofMain.h"
+
+// Window-less controller: the same per-tick pipeline as ofApp (OSC in ->
+// sequencer -> staged LED commit -> hardware tick) with no GL, GUI or draw().
+class HeadlessApp : public ofBaseApp {
+public:
+	struct Settings {
+		int tickRate = 60; // Hz
+		int receivePort = 8000;
+		std::string sequencePath; // optional Vezér XML to play (looped)
+		float runSeconds = 0.0f; // 0 = run until killed
+		float statsInterval = 10.0f; // seconds between status lines, 0 = off
+		std::string recordPath; // capture received OSC to this log
+		std::string replayPath; // feed this capture log back in
+		bool replayFast = false; // replay as fast as possible instead of in recorded timing
+	};
+
+	explicit HeadlessApp(const Settings & settings)
+		: settings(settings)
+		, oscController(&hourglassManager) { }
+
+	void setup() override;
+	void update() override;
+	void exit() override;
+
+private:
+	Settings settings;
+
+	HourGlassManager hourglassManager;
+	VezerPlayer vezerPlayer;
+	OSCController oscController;
+
+	uint64_t ticks = 0;
+	float lastStatsTime = 0.0f;
+
+	void logStats();
+};
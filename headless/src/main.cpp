@@ -0,0 +1,58 @@
+#include "HeadlessApp.h"
+#include "ofAppNoWindow.h"
+#include "ofMain.h"
+
+namespace {
+void printUsage() {
+	std::cout << "usage: myriades_headless [--rate HZ] [--port PORT] [--data DIR] [--sequence FILE]\n"
+				 "                         [--seconds N] [--stats N] [--record FILE] [--replay FILE | --replay-fast FILE]\n"
+				 "  --rate      control tick rate in Hz (default 60)\n"
+				 "  --port      OSC receive port (default 8000)\n"
+				 "  --data      data folder holding hourglasses.json (default ../../bin/data)\n"
+				 "  --sequence  Vezer XML sequence to play in a loop, relative to the data folder\n"
+				 "  --seconds   exit after N seconds (default: run until killed)\n"
+				 "  --stats     seconds between status lines, 0 disables (default 10)\n"
+				 "  --record    capture received OSC to a binary log\n"
+				 "  --replay    feed a capture log back in its recorded timing\n"
+				 "  --replay-fast  feed a capture log back as fast as possible and report throughput\n";
+}
+}
+
+//========================================================================
+int main(int argc, char ** argv) {
+	HeadlessApp::Settings settings;
+	// headless/bin/ -> the main project's bin/data/
+	std::string dataPath = ofFilePath::getCurrentExeDir() + "../../bin/data/";
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--rate" && hasValue) {
+			settings.tickRate = std::max(1, ofToInt(argv[++i]));
+		} else if (arg == "--port" && hasValue) {
+			settings.receivePort = ofToInt(argv[++i]);
+		} else if (arg == "--data" && hasValue) {
+			dataPath = ofFilePath::addTrailingSlash(argv[++i]);
+		} else if (arg == "--sequence" && hasValue) {
+			settings.sequencePath = argv[++i];
+		} else if (arg == "--seconds" && hasValue) {
+			settings.runSeconds = ofToFloat(argv[++i]);
+		} else if (arg == "--stats" && hasValue) {
+			settings.statsInterval = ofToFloat(argv[++i]);
+		} else if (arg == "--record" && hasValue) {
+			settings.recordPath = argv[++i];
+		} else if ((arg == "--replay" || arg == "--replay-fast") && hasValue) {
+			settings.replayPath = argv[++i];
+			settings.replayFast = (arg == "--replay-fast");
+		} else {
+			printUsage();
+			return arg == "--help" || arg == "-h" ? 0 : 1;
+		}
+	}
+	ofSetDataPathRoot(dataPath);
+
+	// No GL context: ofAppNoWindow only drives setup/update (draw is a no-op)
+	auto window = std::make_shared<ofAppNoWindow>();
+	ofSetupOpenGL(window, 1, 1, OF_WINDOW);
+	return ofRunApp(std::make_shared<HeadlessApp>(settings));
+}
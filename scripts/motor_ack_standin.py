@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""
+Stand-in for a motor device in acknowledged mode ("motorAck" in the OSC out config)
+
+Listens where the controller sends motor commands, applies each sequence
+number once, and answers /ack <seq> to the controller's reply port.
+
+Usage:
+  python motor_ack_standin.py                          # listen on 9000, ack to 127.0.0.1:9100
+  python motor_ack_standin.py --port 9001 --reply-port 9100 --drop 0.3   # lose 30% of packets
+"""
+
+import argparse
+import random
+from collections import deque
+
+from pythonosc import dispatcher, osc_server, udp_client
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Ack motor commands like the hourglass firmware")
+    parser.add_argument("--port", type=int, default=9000, help="port motor commands arrive on")
+    parser.add_argument("--reply-host", default="127.0.0.1", help="controller address")
+    parser.add_argument("--reply-port", type=int, default=9100, help="controller motorAck replyPort")
+    parser.add_argument("--drop", type=float, default=0.0, help="fraction of incoming packets to ignore")
+    args = parser.parse_args()
+
+    reply = udp_client.SimpleUDPClient(args.reply_host, args.reply_port)
+    seen = deque(maxlen=256)  # recent sequence numbers, for idempotence
+
+    def on_message(address, *osc_args):
+        if not address.startswith("/motor/") or random.random() < args.drop:
+            return
+        if not osc_args or not isinstance(osc_args[-1], int):
+            print(f"{address} {osc_args} (no sequence number, not acked)")
+            return
+        seq = osc_args[-1]
+        if seq in seen:
+            print(f"{address} #{seq} duplicate, re-acked")
+        else:
+            seen.append(seq)
+            print(f"{address} {list(osc_args[:-1])} #{seq}")
+        reply.send_message("/ack", seq)
+
+    d = dispatcher.Dispatcher()
+    d.set_default_handler(on_message)
+    server = osc_server.BlockingOSCUDPServer(("0.0.0.0", args.port), d)
+    print(f"Acking motor commands on {args.port} -> {args.reply_host}:{args.reply_port}")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -17,11 +17,15 @@ Interactive commands:
   lum 1 0.5          # Set individual luminosity to 50%
   global 0.8         # Set global luminosity to 80%
   blackout           # Turn off all LEDs
+  frame 40 255 0 0   # Packed /system/frame: hourglasses 1-40 red
+  wave 1-4 4 0.25    # Arc sweep, 4 s cycle, each hourglass a quarter cycle later
+  clear all          # Remove effects
   demo               # Run quick demo
   help               # Show help
   quit               # Exit
 """
 
+import struct
 import time
 from pythonosc import udp_client
 
@@ -79,6 +83,36 @@ class OSCTester:
         self.client.send_message(address, [])
         print(f"Sent: {address}")
     
+    def send_effect_arc(self, hourglass_id, min_arc, max_arc, period, phase=0.0, phase_step=0.0):
+        """Arc cosine sweep on the installation clock; phase_step offsets each targeted hourglass"""
+        address = f"/hourglass/{hourglass_id}/effect/arc"
+        self.client.send_message(address, [float(min_arc), float(max_arc), float(period), float(phase), float(phase_step)])
+        print(f"Sent: {address} {min_arc} {max_arc} {period} {phase} {phase_step}")
+
+    def send_effect_clear(self, hourglass_id):
+        """Remove all effects of the targeted hourglasses"""
+        address = f"/hourglass/{hourglass_id}/effect/clear"
+        self.client.send_message(address, [])
+        print(f"Sent: {address}")
+
+    def send_frame(self, records, first_id=1):
+        """Send one packed /system/frame blob (layout: docs/OSC_API_Documentation.md).
+
+        records: list of dicts with optional keys luminosity (0-1) and
+        up/down dicts of r, g, b, main, pwm, blend, origin, arc.
+        """
+        def side(values):
+            return struct.pack(">BBBBBHHH", values.get("r", 0), values.get("g", 0), values.get("b", 0),
+                               values.get("main", 0), values.get("pwm", 0), values.get("blend", 0),
+                               values.get("origin", 0), values.get("arc", 360))
+
+        blob = struct.pack(">BBHH", 1, 0, len(records), first_id)
+        for record in records:
+            luminosity = int(round(record.get("luminosity", 1.0) * 255))
+            blob += struct.pack(">BB", luminosity, 0) + side(record.get("up", {})) + side(record.get("down", {}))
+        self.client.send_message("/system/frame", blob)
+        print(f"Sent: /system/frame ({len(records)} hourglasses from {first_id}, {len(blob)} bytes)")
+    
     # Motor commands
     def send_motor_enable(self, hourglass_id, enable):
         """Enable/disable motor"""
@@ -225,6 +259,9 @@ def interactive_mode():
     print("  lum <hg> <value>         - Set individual luminosity 0-1 (e.g: lum 1 0.5)")
     print("  global <value>           - Set global luminosity 0-1 (e.g: global 0.8)")
     print("  blackout                 - Global blackout")
+    print("  frame <count> <r> <g> <b> - Packed frame, hourglasses 1..count (e.g: frame 40 255 0 0)")
+    print("  wave <hg> <period> <step> - Arc sweep wave, step in cycles per hourglass (e.g: wave 1-4 4 0.25)")
+    print("  clear <hg>               - Remove effects (e.g: clear all)")
     print("")
     print("Motor Commands:")
     print("  motor <hg> enable <0/1>  - Enable/disable motor (e.g: motor 1 enable 1)")
@@ -263,6 +300,9 @@ def interactive_mode():
                 print("  lum <hg> <value>         - Set individual luminosity 0-1 (e.g: lum 1 0.5)")
                 print("  global <value>           - Set global luminosity 0-1 (e.g: global 0.8)")
                 print("  blackout                 - Global blackout")
+                print("  frame <count> <r> <g> <b> - Packed frame, hourglasses 1..count")
+                print("  wave <hg> <period> <step> - Arc sweep wave, step in cycles per hourglass")
+                print("  clear <hg>               - Remove effects")
                 print("  demo                     - Run quick demo")
                 print("  quit                     - Exit")
             elif cmd[0] == "demo":
@@ -310,6 +350,13 @@ def interactive_mode():
                 osc.send_global_luminosity(float(cmd[2]))
             elif cmd[0] == "blackout":
                 osc.send_blackout()
+            elif cmd[0] == "frame" and len(cmd) == 5:
+                color = {"r": int(cmd[2]), "g": int(cmd[3]), "b": int(cmd[4])}
+                osc.send_frame([{"up": color, "down": color}] * int(cmd[1]))
+            elif cmd[0] == "wave" and len(cmd) == 4:
+                osc.send_effect_arc(cmd[1], 90, 360, float(cmd[2]), 0.0, float(cmd[3]))
+            elif cmd[0] == "clear" and len(cmd) == 2:
+                osc.send_effect_clear(cmd[1])
             elif cmd[0] == "motor":
                 if len(cmd) < 3:
                     print("Motor command requires at least 2 arguments. Type 'help' for usage.")
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Just enough JSON to read hourglasses.json without openFrameworks: objects,
+// arrays, strings (\uXXXX escapes are kept verbatim), numbers, true/false/null
+struct JsonValue {
+	enum class Type { Null, Bool, Number, String, Array, Object };
+	Type type = Type::Null;
+	bool boolean = false;
+	double number = 0.0;
+	std::string string;
+	std::vector<JsonValue> items;
+	std::vector<std::pair<std::string, JsonValue>> members;
+
+	const JsonValue * find(const std::string & key) const {
+		if (type != Type::Object) return nullptr;
+		for (const auto & member : members) {
+			if (member.first == key) return &member.second;
+		}
+		return nullptr;
+	}
+	std::string getString(const std::string & key, const std::string & fallback) const {
+		const JsonValue * value = find(key);
+		return value && value->type == Type::String ? value->string : fallback;
+	}
+	int getInt(const std::string & key, int fallback) const {
+		const JsonValue * value = find(key);
+		return value && value->type == Type::Number ? static_cast<int>(value->number) : fallback;
+	}
+	bool getBool(const std::string & key, bool fallback) const {
+		const JsonValue * value = find(key);
+		return value && value->type == Type::Bool ? value->boolean : fallback;
+	}
+};
+
+class JsonReader {
+public:
+	static bool parse(const std::string & text, JsonValue & out, std::string & error) {
+		JsonReader reader(text);
+		if (!reader.parseValue(out) || (reader.skipSpace(), reader.pos != text.size())) {
+			error = "JSON syntax error at offset " + std::to_string(reader.pos);
+			return false;
+		}
+		return true;
+	}
+
+private:
+	explicit JsonReader(const std::string & text)
+		: text(text) { }
+
+	const std::string & text;
+	size_t pos = 0;
+	int depth = 0;
+
+	void skipSpace() {
+		while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+	}
+	bool consume(char c) {
+		skipSpace();
+		if (pos < text.size() && text[pos] == c) {
+			pos++;
+			return true;
+		}
+		return false;
+	}
+	bool literal(const char * word) {
+		size_t length = std::char_traits<char>::length(word);
+		if (text.compare(pos, length, word) != 0) return false;
+		pos += length;
+		return true;
+	}
+
+	bool parseValue(JsonValue & out) {
+		skipSpace();
+		if (pos >= text.size() || depth > 64) return false;
+		char c = text[pos];
+		if (c == '{') return parseObject(out);
+		if (c == '[') return parseArray(out);
+		if (c == '"') {
+			out.type = JsonValue::Type::String;
+			return parseString(out.string);
+		}
+		if (literal("true") || literal("false")) {
+			out.type = JsonValue::Type::Bool;
+			out.boolean = c == 't';
+			return true;
+		}
+		if (literal("null")) {
+			out.type = JsonValue::Type::Null;
+			return true;
+		}
+		const char * start = text.c_str() + pos;
+		char * end = nullptr;
+		out.number = std::strtod(start, &end);
+		if (end == start) return false;
+		out.type = JsonValue::Type::Number;
+		pos += static_cast<size_t>(end - start);
+		return true;
+	}
+
+	bool parseString(std::string & out) {
+		if (text[pos++] != '"') return false;
+		out.clear();
+		while (pos < text.size()) {
+			char c = text[pos++];
+			if (c == '"') return true;
+			if (c != '\\') {
+				out += c;
+				continue;
+			}
+			if (pos >= text.size()) return false;
+			char escaped = text[pos++];
+			switch (escaped) {
+			case 'n': out += '\n'; break;
+			case 't': out += '\t'; break;
+			case 'r': out += '\r'; break;
+			case 'b': out += '\b'; break;
+			case 'f': out += '\f'; break;
+			case 'u': out += "\\u"; break;
+			default: out += escaped; break;
+			}
+		}
+		return false;
+	}
+
+	bool parseArray(JsonValue & out) {
+		out.type = JsonValue::Type::Array;
+		pos++;
+		depth++;
+		if (consume(']')) return depth--, true;
+		do {
+			out.items.emplace_back();
+			if (!parseValue(out.items.back())) return false;
+		} while (consume(','));
+		depth--;
+		return consume(']');
+	}
+
+	bool parseObject(JsonValue & out) {
+		out.type = JsonValue::Type::Object;
+		pos++;
+		depth++;
+		if (consume('}')) return depth--, true;
+		do {
+			skipSpace();
+			std::string key;
+			if (pos >= text.size() || !parseString(key) || !consume(':')) return false;
+			out.members.emplace_back(std::move(key), JsonValue {});
+			if (!parseValue(out.members.back().second)) return false;
+		} while (consume(','));
+		depth--;
+		return consume('}');
+	}
+};
+
+// One simulated device per distinct enabled unicast ip:port in the hourglass
+// "oscOut" blocks. Several hourglasses pointing at the same ip:port share it,
+// as they would share one real controller board.
+struct SimDeviceConfig {
+	std::string ip;
+	int port = 0;
+	std::vector<int> hourglassIds; // 1-based position in "hourglasses", as in /hourglass/{id}
+	std::vector<int> motorIds;
+	int ackReplyPort = 0; // "motorAck" replyPort, 0 when acks are off
+};
+
+// "groupOut" destinations (see HourGlassManager): motor commands addressed to
+// "/<motor ids>/motor/..." for every device at once
+struct SimGroupConfig {
+	std::string ip;
+	int port = 0;
+	bool multicast = false;
+};
+
+struct SimConfig {
+	std::vector<SimDeviceConfig> devices;
+	std::vector<SimGroupConfig> groups;
+	size_t hourglassCount = 0;
+
+	bool load(const std::string & path, std::string & error) {
+		std::ifstream file(path);
+		if (!file) {
+			error = "cannot open " + path;
+			return false;
+		}
+		std::stringstream buffer;
+		buffer << file.rdbuf();
+		JsonValue root;
+		if (!JsonReader::parse(buffer.str(), root, error)) return false;
+		const JsonValue * hourglasses = root.find("hourglasses");
+		if (!hourglasses || hourglasses->type != JsonValue::Type::Array) {
+			error = path + ": missing 'hourglasses' array";
+			return false;
+		}
+
+		std::map<std::string, size_t> byEndpoint;
+		hourglassCount = hourglasses->items.size();
+		for (size_t i = 0; i < hourglasses->items.size(); i++) {
+			const JsonValue & hourglass = hourglasses->items[i];
+			const JsonValue * oscOut = hourglass.find("oscOut");
+			if (!oscOut || !oscOut->getBool("enabled", true)) continue;
+			const JsonValue * destinations = oscOut->find("destinations");
+			if (!destinations || destinations->type != JsonValue::Type::Array) continue;
+			const JsonValue * motorAck = oscOut->find("motorAck");
+			int ackPort = motorAck && motorAck->getBool("enabled", false) ? motorAck->getInt("replyPort", 9100) : 0;
+
+			for (const auto & destination : destinations->items) {
+				if (!destination.getBool("enabled", true) || destination.getString("type", "unicast") != "unicast") continue;
+				std::string ip = destination.getString("ip", "");
+				int port = destination.getInt("port", 0);
+				if (ip.empty() || port <= 0) continue;
+				std::string key = ip + ":" + std::to_string(port);
+				auto it = byEndpoint.find(key);
+				if (it == byEndpoint.end()) {
+					it = byEndpoint.emplace(key, devices.size()).first;
+					devices.push_back(SimDeviceConfig { ip, port, {}, {}, 0 });
+				}
+				SimDeviceConfig & device = devices[it->second];
+				device.hourglassIds.push_back(static_cast<int>(i + 1));
+				device.motorIds.push_back(hourglass.getInt("motorId", static_cast<int>(i + 1)));
+				if (ackPort > 0) device.ackReplyPort = ackPort;
+			}
+		}
+
+		const JsonValue * groupOut = root.find("groupOut");
+		const JsonValue * groupDestinations = groupOut ? groupOut->find("destinations") : nullptr;
+		if (groupOut && groupOut->getBool("enabled", true) && groupDestinations && groupDestinations->type == JsonValue::Type::Array) {
+			for (const auto & destination : groupDestinations->items) {
+				if (!destination.getBool("enabled", true)) continue;
+				SimGroupConfig group { destination.getString("ip", ""), destination.getInt("port", 0), destination.getString("type", "unicast") == "multicast" };
+				if (!group.ip.empty() && group.port > 0) groups.push_back(group);
+			}
+		}
+		return true;
+	}
+
+	// hourglasses.json with `count` hourglasses, each on its own loopback port
+	static std::string generate(int count, int basePort) {
+		std::ostringstream json;
+		json << "{\n  \"serialPort\": \"\",\n  \"baudRate\": 0,\n  \"hourglasses\": [\n";
+		for (int i = 1; i <= count; i++) {
+			json << "    { \"name\": \"HourGlass" << i << "\", \"upLedId\": " << i * 10 + 1 << ", \"downLedId\": " << i * 10 + 2
+				 << ", \"motorId\": " << i << ",\n      \"oscOut\": { \"enabled\": true, \"destinations\": [ { \"name\": \"sim" << i
+				 << "\", \"ip\": \"127.0.0.1\", \"port\": " << basePort + i - 1 << ", \"enabled\": true } ] } }" << (i < count ? ",\n" : "\n");
+		}
+		json << "  ]\n}\n";
+		return json.str();
+	}
+};
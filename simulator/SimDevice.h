@@ -0,0 +1,187 @@
+#pragma once
+
+#include "LatencyHistogram.h"
+#include "OSCMessageView.h"
+#include "SimConfig.h"
+#include <cstdint>
+#include <deque>
+#include <string_view>
+#include <unordered_set>
+
+// State of one simulated hourglass board, fed the device OSC surface that
+// OSCOutController emits:
+//   /rgb/top|bot i rgba i originDeg i arcDeg    /pwr/top|bot i pwm    /mag/top|bot i pwm
+//   /motor/relative|absolute f speed f accel f deg    /motor/relative|absolute/stop f accel
+//   /motor/ustep i    /motor/zero    /motor/homing    /motor/emergency
+// Motor messages may carry one extra trailing int32 sequence number (motorAck);
+// each sequence is applied at most once and acknowledged every time.
+class SimDevice {
+public:
+	struct Side {
+		uint32_t rgba = 0;
+		int originDeg = 0;
+		int arcDeg = 0;
+		int power = 0;
+		int magnet = 0;
+	};
+
+	enum class Result {
+		Applied,
+		Duplicate, // acked motor command seen before
+		Unknown, // address outside the device surface
+		Malformed // known address, wrong arguments
+	};
+
+	struct Counters {
+		uint64_t datagrams = 0;
+		uint64_t bytes = 0;
+		uint64_t messages = 0;
+		uint64_t rgb = 0;
+		uint64_t power = 0;
+		uint64_t magnet = 0;
+		uint64_t motor = 0;
+		uint64_t duplicates = 0;
+		uint64_t unknown = 0;
+		uint64_t malformed = 0;
+		uint64_t ledChanges = 0; // /rgb messages that changed the side's colour
+	};
+
+	explicit SimDevice(const SimDeviceConfig & config)
+		: config(config) { }
+
+	const SimDeviceConfig config;
+	Side top;
+	Side bot;
+	float motorPositionDeg = 0.0f; // moves complete instantly
+	int microstep = 1;
+	uint64_t emergencyStops = 0;
+	Counters total;
+	Counters interval; // since the last report
+
+	// Datagram arrival gaps, us, since the last report
+	LatencyHistogram gaps;
+	uint64_t lastArrivalMicros = 0;
+
+	void recordDatagram(size_t size, uint64_t arrivalMicros) {
+		for (Counters * counters : { &total, &interval }) {
+			counters->datagrams++;
+			counters->bytes += size;
+		}
+		if (lastArrivalMicros != 0 && arrivalMicros > lastArrivalMicros) gaps.record(arrivalMicros - lastArrivalMicros);
+		lastArrivalMicros = arrivalMicros;
+	}
+
+	// address may differ from message.getAddress() when a group prefix was
+	// stripped. ackSequence is set (>= 0) when the sender expects an /ack.
+	Result apply(std::string_view address, const OSCMessageView & message, int64_t & ackSequence, bool & ledChanged) {
+		ackSequence = -1;
+		ledChanged = false;
+		count(&Counters::messages);
+
+		if (address.size() == 8 && (address.substr(0, 5) == "/rgb/" || address.substr(0, 5) == "/pwr/" || address.substr(0, 5) == "/mag/")) {
+			Side * side = sideFor(address.substr(5));
+			if (!side) return unknown();
+			char kind = address[1];
+			if (kind == 'r') {
+				if (!hasInts(message, 3)) return malformed();
+				uint32_t rgba = static_cast<uint32_t>(message.getInt32(0));
+				ledChanged = rgba != side->rgba;
+				side->rgba = rgba;
+				side->originDeg = message.getInt32(1);
+				side->arcDeg = message.getInt32(2);
+				count(&Counters::rgb);
+				if (ledChanged) count(&Counters::ledChanges);
+			} else {
+				if (!hasInts(message, 1)) return malformed();
+				(kind == 'p' ? side->power : side->magnet) = message.getInt32(0);
+				count(kind == 'p' ? &Counters::power : &Counters::magnet);
+			}
+			return Result::Applied;
+		}
+
+		if (address.substr(0, 7) != "/motor/") return unknown();
+		std::string_view command = address.substr(7);
+		size_t floats = 0;
+		size_t ints = 0;
+		if (command == "relative" || command == "absolute") {
+			floats = 3;
+		} else if (command == "relative/stop" || command == "absolute/stop") {
+			floats = 1;
+		} else if (command == "ustep") {
+			ints = 1;
+		} else if (command != "zero" && command != "homing" && command != "emergency") {
+			return unknown();
+		}
+		size_t expected = floats + ints;
+		size_t args = message.getNumArgs();
+		for (size_t i = 0; i < expected && i < args; i++) {
+			if (message.getArgType(i) != (i < floats ? 'f' : 'i')) return malformed();
+		}
+		if (args == expected + 1 && message.getArgType(expected) == 'i') {
+			ackSequence = static_cast<uint32_t>(message.getInt32(expected));
+			if (!rememberSequence(ackSequence)) {
+				count(&Counters::duplicates);
+				return Result::Duplicate;
+			}
+		} else if (args != expected) {
+			return malformed();
+		}
+
+		if (command == "relative") {
+			motorPositionDeg += message.getFloat(2);
+		} else if (command == "absolute") {
+			motorPositionDeg = message.getFloat(2);
+		} else if (command == "ustep") {
+			microstep = message.getInt32(0);
+		} else if (command == "zero" || command == "homing") {
+			motorPositionDeg = 0.0f;
+		} else if (command == "emergency") {
+			emergencyStops++;
+		}
+		count(&Counters::motor);
+		return Result::Applied;
+	}
+
+private:
+	static constexpr size_t SEQUENCE_MEMORY = 256; // like scripts/motor_ack_standin.py
+	std::deque<int64_t> recentSequences;
+	std::unordered_set<int64_t> recentSequenceSet;
+
+	void count(uint64_t Counters::*field) {
+		total.*field += 1;
+		interval.*field += 1;
+	}
+	Result unknown() {
+		count(&Counters::unknown);
+		return Result::Unknown;
+	}
+	Result malformed() {
+		count(&Counters::malformed);
+		return Result::Malformed;
+	}
+
+	Side * sideFor(std::string_view position) {
+		if (position == "top") return &top;
+		if (position == "bot") return &bot;
+		return nullptr;
+	}
+
+	static bool hasInts(const OSCMessageView & message, size_t count) {
+		if (message.getNumArgs() != count) return false;
+		for (size_t i = 0; i < count; i++) {
+			if (message.getArgType(i) != 'i') return false;
+		}
+		return true;
+	}
+
+	// False if the sequence was already applied
+	bool rememberSequence(int64_t sequence) {
+		if (!recentSequenceSet.insert(sequence).second) return false;
+		recentSequences.push_back(sequence);
+		if (recentSequences.size() > SEQUENCE_MEMORY) {
+			recentSequenceSet.erase(recentSequences.front());
+			recentSequences.pop_front();
+		}
+		return true;
+	}
+};
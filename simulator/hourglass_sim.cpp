@@ -0,0 +1,531 @@
+// Hourglass firmware simulator: listens on every device ip:port of an
+// hourglasses.json, applies the device OSC surface (/rgb, /pwr, /mag, /motor)
+// to simulated board state, and reports per-interval receive rates, arrival
+// gaps and command-to-apply latency. One process simulates the whole
+// installation, so the controller's full OSCOutController fan-out for 100+
+// hourglasses can be measured on one Linux machine over loopback.
+//
+// Latency probes (--probe-rate) send /hourglass/{id}/up/rgb to the
+// controller's OSC input, alternating colours, and time how long until that
+// hourglass's device sees its /rgb/top change (kernel receive timestamps).
+// Probes need global and individual luminosity above 0.
+//
+//   make -C simulator
+//   mkdir -p /tmp/sim && simulator/hourglass_sim --write-config 120 /tmp/sim/hourglasses.json   # 127.0.0.1:9000-9119
+//   headless/bin/myriades_headless --data /tmp/sim &
+//   simulator/hourglass_sim --config /tmp/sim/hourglasses.json --probe-rate 20 --seconds 30
+
+#include "HourglassTargetSet.h"
+#include "OSCAddress.h"
+#include "SimConfig.h"
+#include "SimDevice.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <map>
+#include <memory>
+#include <netinet/in.h>
+#include <poll.h>
+#include <random>
+#include <set>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+struct Options {
+	std::string configPath = "bin/data/hourglasses.json";
+	std::string controllerHost = "127.0.0.1";
+	int controllerPort = 8000;
+	double seconds = 0.0; // 0 = until Ctrl-C
+	double interval = 1.0;
+	double probeRate = 0.0; // probes/s, round-robin over hourglasses
+	double drop = 0.0; // fraction of datagrams to ignore, to exercise loss handling
+	bool perDevice = false;
+};
+
+struct Listener {
+	int fd = -1;
+	SimDevice * device = nullptr; // null for a group socket
+	std::string label;
+};
+
+struct Probe {
+	uint64_t sentMicros = 0;
+	bool pending = false;
+	bool red = false; // colour of the last probe, the next one flips it
+};
+
+uint64_t realtimeMicros() {
+	timespec now {};
+	clock_gettime(CLOCK_REALTIME, &now);
+	return static_cast<uint64_t>(now.tv_sec) * 1000000u + static_cast<uint64_t>(now.tv_nsec) / 1000u;
+}
+
+double ms(uint64_t micros) {
+	return static_cast<double>(micros) / 1000.0;
+}
+
+void appendPadded(std::string & out, const std::string & text) {
+	out += text;
+	out.append(4 - text.size() % 4, '\0');
+}
+
+void appendInt32(std::string & out, int32_t value) {
+	uint32_t bits = static_cast<uint32_t>(value);
+	for (int shift = 24; shift >= 0; shift -= 8) {
+		out += static_cast<char>((bits >> shift) & 0xFF);
+	}
+}
+
+std::string encodeIntMessage(const std::string & address, const std::vector<int32_t> & values) {
+	std::string packet;
+	appendPadded(packet, address);
+	appendPadded(packet, "," + std::string(values.size(), 'i'));
+	for (int32_t value : values) {
+		appendInt32(packet, value);
+	}
+	return packet;
+}
+
+bool resolve(const std::string & host, int port, sockaddr_in & out) {
+	out = {};
+	out.sin_family = AF_INET;
+	out.sin_port = htons(static_cast<uint16_t>(port));
+	return inet_pton(AF_INET, host.c_str(), &out.sin_addr) == 1;
+}
+
+// Binds to ip itself when it is local (any 127.x address works on Linux), to
+// the wildcard otherwise; multicast groups are joined on the default interface
+int openListener(const std::string & ip, int port, bool multicast, std::string & error) {
+	sockaddr_in address {};
+	if (!resolve(ip, port, address)) {
+		error = "bad address " + ip;
+		return -1;
+	}
+	int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+	if (fd < 0) {
+		error = std::strerror(errno);
+		return -1;
+	}
+	int on = 1;
+	int bufferSize = 4 << 20;
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+	setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+	bool bound = !multicast && ::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0;
+	if (!bound) {
+		sockaddr_in any = address;
+		any.sin_addr.s_addr = htonl(INADDR_ANY);
+		if (::bind(fd, reinterpret_cast<sockaddr *>(&any), sizeof(any)) != 0) {
+			error = "bind " + ip + ":" + std::to_string(port) + ": " + std::strerror(errno);
+			::close(fd);
+			return -1;
+		}
+	}
+	if (multicast) {
+		ip_mreq membership {};
+		membership.imr_multiaddr = address.sin_addr;
+		membership.imr_interface.s_addr = htonl(INADDR_ANY);
+		if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0) {
+			error = "join " + ip + ": " + std::strerror(errno);
+			::close(fd);
+			return -1;
+		}
+	}
+	return fd;
+}
+
+class Simulator {
+public:
+	Simulator(const Options & options, const SimConfig & config)
+		: options(options)
+		, config(config)
+		, probes(config.hourglassCount + 1) { }
+
+	~Simulator() {
+		for (const auto & listener : listeners) {
+			::close(listener.fd);
+		}
+		if (sendSocket >= 0) ::close(sendSocket);
+	}
+
+	bool open() {
+		sendSocket = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+		if (sendSocket < 0 || !resolve(options.controllerHost, options.controllerPort, controllerAddress)) {
+			std::fprintf(stderr, "hourglass_sim: cannot set up probe/ack socket\n");
+			return false;
+		}
+
+		std::set<int> wildcardPorts;
+		for (const auto & deviceConfig : config.devices) {
+			std::string error;
+			int fd = openListener(deviceConfig.ip, deviceConfig.port, false, error);
+			if (fd < 0) {
+				std::fprintf(stderr, "hourglass_sim: %s, device skipped\n", error.c_str());
+				continue;
+			}
+			sockaddr_in bound {};
+			socklen_t length = sizeof(bound);
+			getsockname(fd, reinterpret_cast<sockaddr *>(&bound), &length);
+			if (bound.sin_addr.s_addr == htonl(INADDR_ANY) && !wildcardPorts.insert(deviceConfig.port).second) {
+				std::fprintf(stderr, "hourglass_sim: %s:%d is not local and port %d is taken, device skipped (use 127.x addresses)\n",
+					deviceConfig.ip.c_str(), deviceConfig.port, deviceConfig.port);
+				::close(fd);
+				continue;
+			}
+			devices.push_back(std::make_unique<SimDevice>(deviceConfig));
+			listeners.push_back(Listener { fd, devices.back().get(), deviceConfig.ip + ":" + std::to_string(deviceConfig.port) });
+		}
+		for (const auto & group : config.groups) {
+			std::string error;
+			int fd = openListener(group.ip, group.port, group.multicast, error);
+			if (fd < 0) {
+				std::fprintf(stderr, "hourglass_sim: group %s\n", error.c_str());
+				continue;
+			}
+			listeners.push_back(Listener { fd, nullptr, group.ip + ":" + std::to_string(group.port) });
+		}
+		if (devices.empty()) {
+			std::fprintf(stderr, "hourglass_sim: no devices to simulate\n");
+			return false;
+		}
+		std::printf("hourglass_sim: %zu devices, %zu group sockets, %zu hourglasses\n", devices.size(), listeners.size() - devices.size(), config.hourglassCount);
+		return true;
+	}
+
+	void run() {
+		std::vector<pollfd> fds;
+		for (const auto & listener : listeners) {
+			fds.push_back(pollfd { listener.fd, POLLIN, 0 });
+		}
+		uint64_t start = realtimeMicros();
+		uint64_t nextReport = start + static_cast<uint64_t>(options.interval * 1e6);
+		uint64_t probePeriod = options.probeRate > 0.0 ? static_cast<uint64_t>(1e6 / options.probeRate) : 0;
+		uint64_t nextProbe = start + probePeriod;
+		intervalStart = start;
+
+		while (!stopRequested) {
+			uint64_t now = realtimeMicros();
+			if (options.seconds > 0.0 && now - start >= static_cast<uint64_t>(options.seconds * 1e6)) break;
+			if (probePeriod > 0 && now >= nextProbe) {
+				sendProbe(now);
+				nextProbe += probePeriod;
+			}
+			if (now >= nextReport) {
+				report(now);
+				nextReport += static_cast<uint64_t>(options.interval * 1e6);
+			}
+
+			uint64_t wake = probePeriod > 0 ? std::min(nextReport, nextProbe) : nextReport;
+			int timeoutMs = wake > now ? static_cast<int>((wake - now + 999) / 1000) : 0;
+			if (poll(fds.data(), fds.size(), timeoutMs) <= 0) continue;
+			for (size_t i = 0; i < fds.size(); i++) {
+				if (fds[i].revents & POLLIN) drain(listeners[i]);
+			}
+		}
+		summary(realtimeMicros() - start);
+	}
+
+private:
+	const Options & options;
+	const SimConfig & config;
+	std::vector<std::unique_ptr<SimDevice>> devices;
+	std::vector<Listener> listeners;
+	int sendSocket = -1;
+	sockaddr_in controllerAddress {};
+	std::mt19937 random { std::random_device {}() };
+
+	std::vector<Probe> probes; // by hourglass id
+	size_t nextProbeHourglass = 0;
+	LatencyHistogram latency; // probe -> /rgb/top change, us, this interval
+	LatencyHistogram totalLatency;
+	uint64_t probesLost = 0; // still pending when the next probe for that hourglass went out
+	uint64_t acksSent = 0;
+	uint64_t groupDatagrams = 0;
+	uint64_t groupMalformed = 0;
+	uint64_t intervalStart = 0;
+
+	void drain(Listener & listener) {
+		char buffer[65536];
+		char control[256];
+		for (;;) {
+			sockaddr_in sender {};
+			iovec io { buffer, sizeof(buffer) };
+			msghdr header {};
+			header.msg_name = &sender;
+			header.msg_namelen = sizeof(sender);
+			header.msg_iov = &io;
+			header.msg_iovlen = 1;
+			header.msg_control = control;
+			header.msg_controllen = sizeof(control);
+			ssize_t size = recvmsg(listener.fd, &header, 0);
+			if (size < 0) return; // EAGAIN: drained
+
+			uint64_t arrival = 0;
+			for (cmsghdr * message = CMSG_FIRSTHDR(&header); message; message = CMSG_NXTHDR(&header, message)) {
+				if (message->cmsg_level == SOL_SOCKET && message->cmsg_type == SCM_TIMESTAMPNS) {
+					timespec stamp {};
+					std::memcpy(&stamp, CMSG_DATA(message), sizeof(stamp));
+					arrival = static_cast<uint64_t>(stamp.tv_sec) * 1000000u + static_cast<uint64_t>(stamp.tv_nsec) / 1000u;
+				}
+			}
+			if (arrival == 0) arrival = realtimeMicros();
+			if (options.drop > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(random) < options.drop) continue;
+
+			if (listener.device) {
+				listener.device->recordDatagram(static_cast<size_t>(size), arrival);
+			} else {
+				groupDatagrams++;
+			}
+			handlePacket(buffer, static_cast<size_t>(size), listener, sender, arrival, 0);
+		}
+	}
+
+	void handlePacket(const char * data, size_t size, Listener & listener, const sockaddr_in & sender, uint64_t arrival, int depth) {
+		if (size >= 16 && std::memcmp(data, "#bundle", 8) == 0) {
+			if (depth > 8) return;
+			for (size_t pos = 16; pos + 4 <= size;) {
+				uint32_t elementSize = (static_cast<uint32_t>(static_cast<unsigned char>(data[pos])) << 24) | (static_cast<uint32_t>(static_cast<unsigned char>(data[pos + 1])) << 16)
+					| (static_cast<uint32_t>(static_cast<unsigned char>(data[pos + 2])) << 8) | static_cast<uint32_t>(static_cast<unsigned char>(data[pos + 3]));
+				pos += 4;
+				if (elementSize > size - pos) {
+					countMalformed(listener);
+					return;
+				}
+				handlePacket(data + pos, elementSize, listener, sender, arrival, depth + 1);
+				pos += elementSize;
+			}
+			return;
+		}
+
+		OSCMessageView message;
+		if (!message.parse(data, size)) {
+			countMalformed(listener);
+			return;
+		}
+		if (listener.device) {
+			apply(*listener.device, message.getAddress(), message, sender, arrival);
+			return;
+		}
+
+		// Group message: "/<motor ids>/motor/..." for the devices it names
+		OSCAddress address(message.getAddress());
+		HourglassTargetSet targets = address.size() > 0 ? HourglassTargetSet::parse(address[0]) : HourglassTargetSet();
+		std::string_view rest = message.getAddress();
+		if (targets.isValid()) rest = rest.substr(address[0].size() + 1);
+		for (auto & device : devices) {
+			bool addressed = !targets.isValid() || targets.isAll();
+			for (int motorId : device->config.motorIds) {
+				addressed = addressed || targets.contains(motorId);
+			}
+			if (addressed) apply(*device, rest, message, sender, arrival);
+		}
+	}
+
+	void apply(SimDevice & device, std::string_view address, const OSCMessageView & message, const sockaddr_in & sender, uint64_t arrival) {
+		int64_t ackSequence = -1;
+		bool ledChanged = false;
+		device.apply(address, message, ackSequence, ledChanged);
+
+		if (ackSequence >= 0 && device.config.ackReplyPort > 0) {
+			sockaddr_in reply = sender;
+			reply.sin_port = htons(static_cast<uint16_t>(device.config.ackReplyPort));
+			std::string ack = encodeIntMessage("/ack", { static_cast<int32_t>(ackSequence) });
+			if (sendto(sendSocket, ack.data(), ack.size(), 0, reinterpret_cast<sockaddr *>(&reply), sizeof(reply)) > 0) acksSent++;
+		}
+
+		if (ledChanged && address == "/rgb/top") {
+			for (int hourglassId : device.config.hourglassIds) {
+				Probe & probe = probes[hourglassId];
+				if (!probe.pending) continue;
+				uint64_t elapsed = arrival > probe.sentMicros ? arrival - probe.sentMicros : 0;
+				latency.record(elapsed);
+				totalLatency.record(elapsed);
+				probe.pending = false;
+			}
+		}
+	}
+
+	void countMalformed(Listener & listener) {
+		if (listener.device) {
+			listener.device->total.malformed++;
+			listener.device->interval.malformed++;
+		} else {
+			groupMalformed++;
+		}
+	}
+
+	void sendProbe(uint64_t now) {
+		if (config.hourglassCount == 0) return;
+		int hourglassId = static_cast<int>(nextProbeHourglass++ % config.hourglassCount) + 1;
+		Probe & probe = probes[hourglassId];
+		if (probe.pending) probesLost++;
+		probe.red = !probe.red;
+		std::string packet = encodeIntMessage("/hourglass/" + std::to_string(hourglassId) + "/up/rgb",
+			{ probe.red ? 255 : 0, 0, probe.red ? 0 : 255 });
+		probe.sentMicros = now;
+		probe.pending = sendto(sendSocket, packet.data(), packet.size(), 0, reinterpret_cast<sockaddr *>(&controllerAddress), sizeof(controllerAddress)) > 0;
+	}
+
+	void report(uint64_t now) {
+		double seconds = std::max(1e-6, static_cast<double>(now - intervalStart) / 1e6);
+		intervalStart = now;
+
+		SimDevice::Counters sum;
+		uint64_t maxGap = 0;
+		uint64_t gapP99 = 0;
+		std::string maxGapDevice = "-";
+		size_t silent = 0;
+		for (auto & device : devices) {
+			const SimDevice::Counters & c = device->interval;
+			sum.datagrams += c.datagrams;
+			sum.bytes += c.bytes;
+			sum.messages += c.messages;
+			sum.rgb += c.rgb;
+			sum.power += c.power;
+			sum.magnet += c.magnet;
+			sum.motor += c.motor;
+			sum.malformed += c.malformed;
+			sum.unknown += c.unknown;
+			if (c.datagrams == 0) silent++;
+			gapP99 = std::max(gapP99, device->gaps.percentile(0.99));
+			if (device->gaps.getMax() > maxGap) {
+				maxGap = device->gaps.getMax();
+				maxGapDevice = device->config.ip + ":" + std::to_string(device->config.port);
+			}
+			device->interval = SimDevice::Counters {};
+			device->gaps.reset();
+		}
+
+		std::printf("rx %.0f dgram/s %.0f msg/s %.1f KB/s | rgb %.0f pwr %.0f mag %.0f motor %.0f /s | gap p99<=%.1f ms max %.1f ms (%s), %zu silent",
+			sum.datagrams / seconds, sum.messages / seconds, sum.bytes / seconds / 1024.0, sum.rgb / seconds, sum.power / seconds,
+			sum.magnet / seconds, sum.motor / seconds, ms(gapP99), ms(maxGap), maxGapDevice.c_str(), silent);
+		if (latency.getCount() > 0) {
+			std::printf(" | latency p50<=%.1f p99<=%.1f max %.1f ms (%llu)", ms(latency.percentile(0.5)), ms(latency.percentile(0.99)),
+				ms(latency.getMax()), static_cast<unsigned long long>(latency.getCount()));
+		}
+		if (sum.malformed + sum.unknown > 0) {
+			std::printf(" | malformed %llu unknown %llu", static_cast<unsigned long long>(sum.malformed), static_cast<unsigned long long>(sum.unknown));
+		}
+		std::printf("\n");
+		std::fflush(stdout);
+		latency.reset();
+	}
+
+	void summary(uint64_t elapsedMicros) {
+		double seconds = std::max(1e-6, static_cast<double>(elapsedMicros) / 1e6);
+		SimDevice::Counters sum;
+		for (const auto & device : devices) {
+			const SimDevice::Counters & c = device->total;
+			sum.datagrams += c.datagrams;
+			sum.bytes += c.bytes;
+			sum.messages += c.messages;
+			sum.motor += c.motor;
+			sum.duplicates += c.duplicates;
+			sum.malformed += c.malformed;
+			sum.unknown += c.unknown;
+		}
+		std::printf("\nhourglass_sim: %.1f s, %llu datagrams (%.0f/s), %llu messages, %.1f KB, %llu motor commands, %llu duplicate, %llu acks sent, %llu malformed, %llu unknown, %llu group datagrams\n",
+			seconds, static_cast<unsigned long long>(sum.datagrams), sum.datagrams / seconds, static_cast<unsigned long long>(sum.messages),
+			sum.bytes / 1024.0, static_cast<unsigned long long>(sum.motor), static_cast<unsigned long long>(sum.duplicates),
+			static_cast<unsigned long long>(acksSent), static_cast<unsigned long long>(sum.malformed + groupMalformed),
+			static_cast<unsigned long long>(sum.unknown), static_cast<unsigned long long>(groupDatagrams));
+		if (totalLatency.getCount() > 0) {
+			std::printf("latency: %llu probes applied, p50<=%.1f p99<=%.1f max %.1f ms, %llu lost\n", static_cast<unsigned long long>(totalLatency.getCount()),
+				ms(totalLatency.percentile(0.5)), ms(totalLatency.percentile(0.99)), ms(totalLatency.getMax()), static_cast<unsigned long long>(probesLost));
+		}
+		if (!options.perDevice) return;
+		for (const auto & device : devices) {
+			const SimDevice::Counters & c = device->total;
+			std::printf("  %s:%d  %llu dgram %llu msg  rgb %llu (%llu changes) pwr %llu mag %llu motor %llu  top #%08x bot #%08x  motor %.1f deg  estop %llu\n",
+				device->config.ip.c_str(), device->config.port, static_cast<unsigned long long>(c.datagrams), static_cast<unsigned long long>(c.messages),
+				static_cast<unsigned long long>(c.rgb), static_cast<unsigned long long>(c.ledChanges), static_cast<unsigned long long>(c.power),
+				static_cast<unsigned long long>(c.magnet), static_cast<unsigned long long>(c.motor), device->top.rgba, device->bot.rgba,
+				device->motorPositionDeg, static_cast<unsigned long long>(device->emergencyStops));
+		}
+	}
+};
+
+void printUsage() {
+	std::printf("usage: hourglass_sim [--config hourglasses.json] [--seconds S] [--interval S] [--probe-rate HZ]\n"
+				"                     [--controller HOST:PORT] [--drop FRACTION] [--per-device]\n"
+				"       hourglass_sim --write-config COUNT PATH [--base-port 9000]\n");
+}
+
+} // namespace
+
+int main(int argc, char ** argv) {
+	Options options;
+	int writeCount = 0;
+	std::string writePath;
+	int basePort = 9000;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--config" && hasValue) {
+			options.configPath = argv[++i];
+		} else if (arg == "--seconds" && hasValue) {
+			options.seconds = std::atof(argv[++i]);
+		} else if (arg == "--interval" && hasValue) {
+			options.interval = std::max(0.1, std::atof(argv[++i]));
+		} else if (arg == "--probe-rate" && hasValue) {
+			options.probeRate = std::atof(argv[++i]);
+		} else if (arg == "--drop" && hasValue) {
+			options.drop = std::atof(argv[++i]);
+		} else if (arg == "--controller" && hasValue) {
+			std::string target = argv[++i];
+			size_t colon = target.rfind(':');
+			options.controllerHost = target.substr(0, colon);
+			if (colon != std::string::npos) options.controllerPort = std::atoi(target.c_str() + colon + 1);
+		} else if (arg == "--per-device") {
+			options.perDevice = true;
+		} else if (arg == "--write-config" && i + 2 < argc) {
+			writeCount = std::atoi(argv[++i]);
+			writePath = argv[++i];
+		} else if (arg == "--base-port" && hasValue) {
+			basePort = std::atoi(argv[++i]);
+		} else {
+			printUsage();
+			return arg == "--help" || arg == "-h" ? 0 : 1;
+		}
+	}
+
+	if (writeCount > 0) {
+		std::FILE * file = std::fopen(writePath.c_str(), "w");
+		if (!file) {
+			std::fprintf(stderr, "hourglass_sim: cannot write %s\n", writePath.c_str());
+			return 1;
+		}
+		std::string json = SimConfig::generate(writeCount, basePort);
+		std::fwrite(json.data(), 1, json.size(), file);
+		std::fclose(file);
+		std::printf("hourglass_sim: wrote %d hourglasses on 127.0.0.1:%d-%d to %s\n", writeCount, basePort, basePort + writeCount - 1, writePath.c_str());
+		return 0;
+	}
+
+	SimConfig config;
+	std::string error;
+	if (!config.load(options.configPath, error)) {
+		std::fprintf(stderr, "hourglass_sim: %s\n", error.c_str());
+		return 1;
+	}
+
+	std::signal(SIGINT, [](int) { stopRequested = 1; });
+	std::signal(SIGTERM, [](int) { stopRequested = 1; });
+	Simulator simulator(options, config);
+	if (!simulator.open()) return 1;
+	simulator.run();
+	return 0;
+}
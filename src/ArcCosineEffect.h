@@ -1,14 +1,25 @@
 #pragma once
 
-#include "Effect.h"
-#include "ofMain.h" // For ofMap, cos, TWO_PI if needed, or use std::cos
+#include "EffectParameters.h"
 
-class ArcCosineEffect : public Effect {
+// Sweeps the arc between minArc and maxArc on a cosine. A pure function of
+// the installation clock (EffectEngine) plus this instance's period and
+// phase, so instances with the same period stay locked together and a phase
+// step per hourglass makes the sweep travel across the installation.
+// A plain value type: EffectEngine stores instances in a contiguous pool and
+// calls apply directly (no virtual dispatch).
+class ArcCosineEffect {
 public:
-	ArcCosineEffect(float minArc = 90.0f, float maxArc = 360.0f, float periodSeconds = 5.0f);
+	// Only shapes the arc, so it is not evaluated for a dark side
+	static constexpr bool SKIP_WHEN_DARK = true;
 
-	void apply(EffectParameters & params) override;
-	void update(float deltaTime) override;
+	// phase: offset in periods (0.25 = a quarter cycle ahead)
+	ArcCosineEffect(float minArc = 90.0f, float maxArc = 360.0f, float periodSeconds = 5.0f, float phase = 0.0f);
+
+	void apply(EffectParameters & params, double clockSeconds) const;
+
+	void setEnabled(bool enable) { enabled = enable; }
+	bool isEnabled() const { return enabled; }
 
 	void setMinArc(float minArc) { this->minArc = minArc; }
 	float getMinArc() const { return minArc; }
@@ -16,12 +27,16 @@ public:
 	void setMaxArc(float maxArc) { this->maxArc = maxArc; }
 	float getMaxArc() const { return maxArc; }
 
-	void setPeriod(float periodSeconds) { this->periodSeconds = periodSeconds; }
+	void setPeriod(float periodSeconds) { this->periodSeconds = periodSeconds > 0.0f ? periodSeconds : 1.0f; }
 	float getPeriod() const { return periodSeconds; }
 
+	void setPhase(float phase) { this->phase = phase; }
+	float getPhase() const { return phase; }
+
 private:
+	bool enabled;
 	float minArc;
 	float maxArc;
 	float periodSeconds;
-	float elapsedTime;
-};
\ No newline at end of file
+	float phase;
+};
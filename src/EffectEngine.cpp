@@ -0,0 +1,60 @@
+#include "EffectEngine.h"
+
+void EffectEngine::clear() {
+	forEachPool([](auto & pool) {
+		pool.slots.clear();
+		pool.effects.clear();
+	});
+}
+
+void EffectEngine::clearSlot(size_t slot) {
+	eraseSlots(slot, 1, false);
+}
+
+void EffectEngine::removeSlots(size_t first, size_t count) {
+	eraseSlots(first, count, true);
+}
+
+void EffectEngine::eraseSlots(size_t first, size_t count, bool shiftLater) {
+	forEachPool([=](auto & pool) {
+		size_t kept = 0;
+		for (size_t i = 0; i < pool.slots.size(); i++) {
+			size_t slot = pool.slots[i];
+			if (slot >= first && slot < first + count) continue;
+			pool.slots[kept] = (shiftLater && slot >= first + count) ? slot - count : slot;
+			pool.effects[kept] = std::move(pool.effects[i]);
+			kept++;
+		}
+		pool.slots.resize(kept);
+		pool.effects.erase(pool.effects.begin() + kept, pool.effects.end());
+	});
+}
+
+size_t EffectEngine::size() const {
+	size_t total = 0;
+	forEachPool([&total](const auto & pool) { total += pool.effects.size(); });
+	return total;
+}
+
+size_t EffectEngine::count(size_t slot) const {
+	size_t total = 0;
+	forEachPool([&total, slot](const auto & pool) {
+		for (size_t attached : pool.slots) {
+			if (attached == slot) total++;
+		}
+	});
+	return total;
+}
+
+void EffectEngine::apply(std::vector<EffectParameters> & params) const {
+	double clock = clockSeconds;
+	forEachPool([&params, clock](const auto & pool) {
+		using Effect = typename std::decay_t<decltype(pool.effects)>::value_type;
+		for (size_t i = 0; i < pool.effects.size(); i++) {
+			size_t slot = pool.slots[i];
+			if (slot >= params.size() || !pool.effects[i].isEnabled()) continue;
+			if (Effect::SKIP_WHEN_DARK && params[slot].dark) continue;
+			pool.effects[i].apply(params[slot], clock);
+		}
+	});
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "ArcCosineEffect.h"
+#include "EffectParameters.h"
+#include <algorithm>
+#include <chrono>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Effect instances for the whole installation, stored by concrete type in
+// contiguous pools and attached to one LED side each (slot numbering as in
+// LedFrame: hourglass index * 2, + 1 for the bottom). Each tick every pool is
+// applied in one loop over its instances, without virtual calls.
+//
+// Effects hold no running state: they are evaluated from the one shared
+// installation clock, so every instance stays in phase with the others and
+// an instance that is skipped (disabled, or its side is dark) loses nothing.
+//
+// Order is fixed: pools in the order of the Pools tuple below, within a pool
+// by slot, then by the order effects were added. A new effect type is a value
+// class with apply(EffectParameters &, double clockSeconds) const and
+// SKIP_WHEN_DARK (true when it only shapes light that is already there),
+// added there.
+class EffectEngine {
+public:
+	template <typename T>
+	void add(size_t slot, T effect) {
+		Pool<T> & pool = std::get<Pool<T>>(pools);
+		size_t pos = pool.slots.size();
+		while (pos > 0 && pool.slots[pos - 1] > slot) pos--;
+		pool.slots.insert(pool.slots.begin() + pos, slot);
+		pool.effects.insert(pool.effects.begin() + pos, std::move(effect));
+	}
+
+	// Like add(), but replaces the slot's existing effects of type T, so a
+	// repeated command updates the effect instead of stacking copies
+	template <typename T>
+	void set(size_t slot, T effect) {
+		Pool<T> & pool = std::get<Pool<T>>(pools);
+		auto first = std::lower_bound(pool.slots.begin(), pool.slots.end(), slot);
+		auto last = std::upper_bound(first, pool.slots.end(), slot);
+		size_t begin = first - pool.slots.begin();
+		size_t end = last - pool.slots.begin();
+		pool.slots.erase(first, last);
+		pool.effects.erase(pool.effects.begin() + begin, pool.effects.begin() + end);
+		pool.slots.insert(pool.slots.begin() + begin, slot);
+		pool.effects.insert(pool.effects.begin() + begin, std::move(effect));
+	}
+
+	void clear();
+	void clearSlot(size_t slot);
+	// Drops the effects of slots [first, first + count) and moves later slots
+	// down, for a removed hourglass
+	void removeSlots(size_t first, size_t count);
+
+	size_t size() const; // instances across all pools
+	size_t count(size_t slot) const;
+
+	// Installation clock, seconds: read from the steady clock once per tick by
+	// update(), relative to an epoch (engine creation, moved by setClock() to
+	// line it up with another controller). Never summed from frame deltas, so
+	// it does not drift from real time.
+	void update() { clockSeconds = std::chrono::duration<double>(Clock::now() - epoch).count(); }
+	double getClock() const { return clockSeconds; }
+	void setClock(double seconds) {
+		epoch = Clock::now() - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+		clockSeconds = seconds;
+	}
+
+	void apply(std::vector<EffectParameters> & params) const; // params[slot]
+
+private:
+	template <typename T>
+	struct Pool {
+		std::vector<size_t> slots; // sorted
+		std::vector<T> effects; // effects[i] is attached to slots[i]
+	};
+	using Pools = std::tuple<Pool<ArcCosineEffect>>;
+	Pools pools;
+	using Clock = std::chrono::steady_clock;
+	Clock::time_point epoch = Clock::now();
+	double clockSeconds = 0.0;
+
+	void eraseSlots(size_t first, size_t count, bool shiftLater);
+
+	template <typename F>
+	void forEachPool(F fn) {
+		std::apply([&](auto &... pool) { (fn(pool), ...); }, pools);
+	}
+	template <typename F>
+	void forEachPool(F fn) const {
+		std::apply([&](const auto &... pool) { (fn(pool), ...); }, pools);
+	}
+};
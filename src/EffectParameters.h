@@ -14,6 +14,7 @@ struct EffectParameters {
 	int mainLedValue = 0;
 
 	float deltaTime = 0.0f; // Time since last frame for time-based effects
+	bool dark = false; // Nothing lit (black colour or zero luminosity): light-shaping effects are skipped
 	// HourGlass* hourglass = nullptr; // Optional: context of the hourglass if an effect needs it
 
 	// Add any other parameters an effect might want to influence
@@ -41,8 +41,6 @@ HourGlass::HourGlass(const std::string & name)
 	, motorId(0)
 	, updatingFromOSC(false)
 	, connected(false)
-	, upEffectsManager()
-	, downEffectsManager()
 	, oscOutController(nullptr) {
 }
 
@@ -163,13 +161,13 @@ void HourGlass::disableMotor() {
 	}
 }
 
-void HourGlass::emergencyStop() {
+void HourGlass::emergencyStop(bool sendOSC) {
 	if (motor) {
 		motor->emergencyStop();
 	}
 
 	// Send OSC message if not updating from OSC (avoid feedback loops)
-	if (isOSCOutEnabled() && !updatingFromOSC) {
+	if (sendOSC && isOSCOutEnabled() && !updatingFromOSC) {
 		oscOutController->sendMotorEmergency(motorId);
 	}
 }
@@ -179,8 +177,17 @@ void HourGlass::refreshLedState() {
 	if (downLedMagnet) downLedMagnet->resetLastSentValues();
 }
 
+void HourGlass::requestLedRefresh(bool top) {
+	(top ? upLedRefresh : downLedRefresh) = true;
+}
+
+size_t HourGlass::getLedRefreshBytes(bool top) {
+	if (!isOSCOutEnabled()) return 0;
+	return oscOutController->getLedStateBytes(top ? "top" : "bot");
+}
+
 void HourGlass::setAllLEDs(uint8_t r, uint8_t g, uint8_t b) {
-	// Only updates parameters; the actual send happens in applyLedParameters()
+	// Only updates parameters; the actual send happens in emitLedParameters()
 	// on the next frame. If OSC is the origin of this call, 'updatingFromOSC'
 	// must be true BEFORE the parameters are set so UI listeners can ignore it.
 	upLedColor.set(ofColor(r, g, b));
@@ -237,7 +244,7 @@ void HourGlass::applyMotorParameters() {
 			motor->moveRelativeAngle(currentSpeed, currentAccel, targetRelativeDegrees, gearRatio.get(), calibrationFactor.get());
 		}
 
-		if (isOSCOutEnabled() && !updatingFromOSC) {
+		if (relativeAngleSendOSC && isOSCOutEnabled() && !updatingFromOSC) {
 			oscOutController->sendMotorRelative(motorId, currentSpeed, currentAccel, targetRelativeDegrees);
 		}
 		executeRelativeAngle = false;
@@ -247,7 +254,7 @@ void HourGlass::applyMotorParameters() {
 			motor->moveAbsoluteAngle(currentSpeed, currentAccel, targetAbsoluteDegrees, gearRatio.get(), calibrationFactor.get());
 		}
 
-		if (isOSCOutEnabled() && !updatingFromOSC) {
+		if (absoluteAngleSendOSC && isOSCOutEnabled() && !updatingFromOSC) {
 			oscOutController->sendMotorAbsolute(motorId, currentSpeed, currentAccel, targetAbsoluteDegrees);
 		}
 		executeAbsoluteAngle = false;
@@ -258,40 +265,12 @@ void HourGlass::applyMotorParameters() {
 	pendingMoveAccel = std::nullopt;
 }
 
-void HourGlass::updateEffects(float deltaTime) {
-	upEffectsManager.update(deltaTime);
-	downEffectsManager.update(deltaTime);
-}
-
-void HourGlass::addUpEffect(std::unique_ptr<Effect> effect) {
-	if (effect) {
-		upEffectsManager.addEffect(std::move(effect));
-	}
-}
-
-void HourGlass::addDownEffect(std::unique_ptr<Effect> effect) {
-	if (effect) {
-		downEffectsManager.addEffect(std::move(effect));
-	}
-}
-
-void HourGlass::clearUpEffects() {
-	upEffectsManager.clearEffects();
-}
-
-void HourGlass::clearDownEffects() {
-	downEffectsManager.clearEffects();
-}
-
-// Shared UP/DOWN pipeline: effects -> controller -> change-tracked OSC out
-void HourGlass::applyLedSide(LedMagnetController * controller, EffectsManager & effectsManager,
-	const char * oscPosition,
+// Base LED values of one side, before effects
+void HourGlass::getLedSideParameters(EffectParameters & params,
 	const ofParameter<ofColor> & colorParam, const ofParameter<int> & mainLedParam,
 	const ofParameter<int> & blendParam, const ofParameter<int> & originParam,
-	const ofParameter<int> & arcParam, const ofParameter<int> & pwmParam,
-	LedSideState & lastSent, float dt) {
+	const ofParameter<int> & arcParam, float dt) const {
 
-	EffectParameters params;
 	params.color = colorParam.get();
 	params.mainLedValue = mainLedParam.get();
 	params.blend = blendParam.get();
@@ -299,60 +278,62 @@ void HourGlass::applyLedSide(LedMagnetController * controller, EffectsManager &
 	params.arc = arcParam.get();
 	params.effectLuminosityMultiplier = 1.0f;
 	params.deltaTime = dt;
+	params.dark = (params.color.r == 0 && params.color.g == 0 && params.color.b == 0)
+		|| individualLuminosity.get() <= 0.0f || LedMagnetController::getGlobalLuminosity() <= 0.0f;
+}
 
-	effectsManager.processEffects(params);
+// Effects output -> frame slot; gamma and luminosity are applied for all slots at once in LedFrame::process()
+void HourGlass::stageLedSide(LedFrame & frame, size_t slot, const EffectParameters & params,
+	const ofParameter<int> & pwmParam, bool & refresh) {
 
 	float finalIndividualLuminosity = individualLuminosity.get() * params.effectLuminosityMultiplier;
+	frame.stage(slot, params.color.r, params.color.g, params.color.b,
+		params.blend, params.origin, params.arc, finalIndividualLuminosity,
+		static_cast<uint8_t>(params.mainLedValue), static_cast<uint8_t>(pwmParam.get()), refresh);
+	refresh = false;
+}
 
-	// UNIFIED COMMAND: Send all LED parameters in one consistent format
+// Processed frame slot -> controller state (visualizer) and OSC messages for what changed
+void HourGlass::emitLedSide(LedFrame & frame, size_t slot, LedMagnetController * controller, const char * oscPosition) {
 	if (controller) {
-		controller->sendAllLEDParameters(
-			params.color.r, params.color.g, params.color.b,
-			params.blend, params.origin, params.arc,
-			static_cast<uint8_t>(params.mainLedValue),
-			static_cast<uint8_t>(pwmParam.get()),
-			finalIndividualLuminosity);
+		controller->setOutputState(ofColor(frame.outR[slot], frame.outG[slot], frame.outB[slot]),
+			frame.outBlend[slot], frame.outOrigin[slot], frame.outArc[slot],
+			frame.outMainLed[slot], frame.pwm[slot]);
 	}
 
-	// Send OSC messages - only what actually changed
-	if (isOSCOutEnabled() && !updatingFromOSC) {
-		bool rgbChanged = (params.color != lastSent.color || params.origin != lastSent.origin || params.arc != lastSent.arc || finalIndividualLuminosity != lastSent.luminosity);
-		bool mainLedChanged = (params.mainLedValue != lastSent.mainLed);
-		bool pwmChanged = (pwmParam.get() != lastSent.pwm);
-
-		if (rgbChanged) {
-			uint8_t masterAlpha = static_cast<uint8_t>(finalIndividualLuminosity * 255.0f);
-			oscOutController->sendRGBLED(oscPosition, params.color.r, params.color.g, params.color.b,
-				masterAlpha, params.origin, params.arc);
-
-			lastSent.color = params.color;
-			lastSent.origin = params.origin;
-			lastSent.arc = params.arc;
-			lastSent.luminosity = finalIndividualLuminosity;
-		}
-
-		if (mainLedChanged) {
-			oscOutController->sendPowerLED(oscPosition, static_cast<uint8_t>(params.mainLedValue));
-			lastSent.mainLed = params.mainLedValue;
-		}
+	// Send OSC messages - only what actually changed, or everything on a refresh
+	uint8_t changes = frame.getChanges(slot);
+	if (changes == 0 || !isOSCOutEnabled() || updatingFromOSC) return;
 
-		if (pwmChanged) {
-			oscOutController->sendMagnet(oscPosition, static_cast<uint8_t>(pwmParam.get()));
-			lastSent.pwm = pwmParam.get();
-		}
+	if (changes & LedFrame::CHANGE_RGB) {
+		oscOutController->sendRGBLED(oscPosition, frame.r[slot], frame.g[slot], frame.b[slot],
+			frame.alpha[slot], frame.origin[slot], frame.arc[slot]);
+	}
+	if (changes & LedFrame::CHANGE_POWER) {
+		oscOutController->sendPowerLED(oscPosition, frame.mainLed[slot]);
+	}
+	if (changes & LedFrame::CHANGE_MAGNET) {
+		oscOutController->sendMagnet(oscPosition, frame.pwm[slot]);
 	}
+	frame.commit(slot);
 }
 
-void HourGlass::applyLedParameters() {
-	float dt = ofGetLastFrameTime();
+void HourGlass::getLedEffectParameters(EffectParameters & top, EffectParameters & bottom, float dt) const {
+	getLedSideParameters(top, upLedColor, upMainLed, upLedBlend, upLedOrigin, upLedArc, dt);
+	getLedSideParameters(bottom, downLedColor, downMainLed, downLedBlend, downLedOrigin, downLedArc, dt);
+}
+
+void HourGlass::stageLedParameters(LedFrame & frame, size_t firstSlot, const EffectParameters & top, const EffectParameters & bottom) {
+	stageLedSide(frame, firstSlot, top, upPwm, upLedRefresh);
+	stageLedSide(frame, firstSlot + 1, bottom, downPwm, downLedRefresh);
+}
 
-	applyLedSide(upLedMagnet.get(), upEffectsManager, "top",
-		upLedColor, upMainLed, upLedBlend, upLedOrigin, upLedArc, upPwm,
-		lastUpSent, dt);
+void HourGlass::emitLedParameters(LedFrame & frame, size_t firstSlot) {
+	emitLedSide(frame, firstSlot, upLedMagnet.get(), "top");
+	emitLedSide(frame, firstSlot + 1, downLedMagnet.get(), "bot");
 
-	applyLedSide(downLedMagnet.get(), downEffectsManager, "bot",
-		downLedColor, downMainLed, downLedBlend, downLedOrigin, downLedArc, downPwm,
-		lastDownSent, dt);
+	// Both sides' changes leave as one datagram per destination
+	if (oscOutController) oscOutController->flushFrame();
 }
 
 void HourGlass::commandRelativeMove(int steps, std::optional<int> speed, std::optional<int> accel) {
@@ -369,27 +350,29 @@ void HourGlass::commandAbsoluteMove(int position, std::optional<int> speed, std:
 	executeAbsoluteMove = true;
 }
 
-void HourGlass::commandRelativeAngle(float degrees, std::optional<int> speed, std::optional<int> accel) {
+void HourGlass::commandRelativeAngle(float degrees, std::optional<int> speed, std::optional<int> accel, bool sendOSC) {
 	targetRelativeDegrees = degrees;
 	pendingMoveSpeed = speed;
 	pendingMoveAccel = accel;
+	relativeAngleSendOSC = sendOSC;
 	executeRelativeAngle = true;
 }
 
-void HourGlass::commandAbsoluteAngle(float degrees, std::optional<int> speed, std::optional<int> accel) {
+void HourGlass::commandAbsoluteAngle(float degrees, std::optional<int> speed, std::optional<int> accel, bool sendOSC) {
 	targetAbsoluteDegrees = degrees;
 	pendingMoveSpeed = speed;
 	pendingMoveAccel = accel;
+	absoluteAngleSendOSC = sendOSC;
 	executeAbsoluteAngle = true;
 }
 
-void HourGlass::setMotorZero() {
+void HourGlass::setMotorZero(bool sendOSC) {
 	if (motor) {
 		motor->setZero();
 	}
 
 	// Send OSC message if not updating from OSC (avoid feedback loops)
-	if (isOSCOutEnabled() && !updatingFromOSC) {
+	if (sendOSC && isOSCOutEnabled() && !updatingFromOSC) {
 		oscOutController->sendMotorZero(motorId);
 	}
 }
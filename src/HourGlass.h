@@ -1,8 +1,7 @@
 #pragma once
 
-#include "Effect.h"
 #include "EffectParameters.h"
-#include "EffectsManager.h"
+#include "LedFrame.h"
 #include "LedMagnetController.h"
 #include "MotorController.h"
 #include "OSCOutController.h"
@@ -44,17 +43,30 @@ public:
 	// Convenience methods for common operations
 	void enableMotor();
 	void disableMotor();
-	void emergencyStop();
-	void setMotorZero();
+	// sendOSC = false when the command already went out to a group destination
+	void emergencyStop(bool sendOSC = true);
+	void setMotorZero(bool sendOSC = true);
 	void setAllLEDs(uint8_t r, uint8_t g, uint8_t b);
 
-	// Invalidate LED last-sent caches so next applyLedParameters re-sends
-	// (needed after global/individual luminosity changes)
+	// Invalidate LED last-sent caches (needed after global/individual luminosity changes)
 	void refreshLedState();
 
+	// Full-state refresh of one side (top = up): the next emitLedParameters()
+	// re-sends all of its LED messages even if unchanged. getLedRefreshBytes()
+	// is what that costs on the wire (0 when OSC out is off).
+	void requestLedRefresh(bool top);
+	size_t getLedRefreshBytes(bool top);
+
 	// Parameter-driven methods for OSC/GUI sync
 	void applyMotorParameters();
-	void applyLedParameters();
+
+	// LED output, driven by HourGlassManager::update for the whole
+	// installation: base values per side, effects (EffectEngine), staging into
+	// the LedFrame, one LedFrame::process() pass, then emitting what changed.
+	// firstSlot is the top side's slot, firstSlot + 1 the bottom's.
+	void getLedEffectParameters(EffectParameters & top, EffectParameters & bottom, float dt) const;
+	void stageLedParameters(LedFrame & frame, size_t firstSlot, const EffectParameters & top, const EffectParameters & bottom);
+	void emitLedParameters(LedFrame & frame, size_t firstSlot);
 
 	// Status
 	std::string getName() const { return name; }
@@ -101,18 +113,11 @@ public:
 	void markLedParametersDirty() const { ledParametersDirty = true; }
 	void markMotorParametersDirty() const { motorParametersDirty = true; }
 
-	// Effects Management
-	void updateEffects(float deltaTime);
-	void addUpEffect(std::unique_ptr<Effect> effect);
-	void addDownEffect(std::unique_ptr<Effect> effect);
-	void clearUpEffects();
-	void clearDownEffects();
-
 	// New Motor Command Intent Methods
 	void commandRelativeMove(int steps, std::optional<int> speed = std::nullopt, std::optional<int> accel = std::nullopt);
 	void commandAbsoluteMove(int position, std::optional<int> speed = std::nullopt, std::optional<int> accel = std::nullopt);
-	void commandRelativeAngle(float degrees, std::optional<int> speed = std::nullopt, std::optional<int> accel = std::nullopt);
-	void commandAbsoluteAngle(float degrees, std::optional<int> speed = std::nullopt, std::optional<int> accel = std::nullopt);
+	void commandRelativeAngle(float degrees, std::optional<int> speed = std::nullopt, std::optional<int> accel = std::nullopt, bool sendOSC = true);
+	void commandAbsoluteAngle(float degrees, std::optional<int> speed = std::nullopt, std::optional<int> accel = std::nullopt, bool sendOSC = true);
 
 	// New method for minimal view drawing
 	void drawMinimal(float x, float y);
@@ -135,9 +140,6 @@ private:
 
 	bool connected;
 
-	EffectsManager upEffectsManager;
-	EffectsManager downEffectsManager;
-
 	// Motor Command Intent State
 	bool executeRelativeMove = false;
 	int targetRelativeSteps = 0;
@@ -149,28 +151,27 @@ private:
 
 	bool executeRelativeAngle = false;
 	float targetRelativeDegrees = 0.0f;
+	bool relativeAngleSendOSC = true; // false: a group destination already sent it
 
 	bool executeAbsoluteAngle = false;
 	float targetAbsoluteDegrees = 0.0f;
+	bool absoluteAngleSendOSC = true;
 
 	// Helper methods
 	void setupControllers();
 
-	// Last values mirrored to OSC-out, to prevent spam (one struct per side)
-	struct LedSideState {
-		ofColor color;
-		int origin = -1, arc = -1, pwm = -1, mainLed = -1;
-		float luminosity = -1.0f;
-	};
-	LedSideState lastUpSent, lastDownSent;
-
-	// Shared UP/DOWN pipeline: effects -> controller -> change-tracked OSC out
-	void applyLedSide(LedMagnetController * controller, EffectsManager & effectsManager,
-		const char * oscPosition,
+	// Pending full-state refresh per side, handed to the LedFrame when staged
+	bool upLedRefresh = false;
+	bool downLedRefresh = false;
+
+	// Shared UP/DOWN halves: effects output -> frame slot, frame slot -> controller + change-tracked OSC out
+	void getLedSideParameters(EffectParameters & params,
 		const ofParameter<ofColor> & colorParam, const ofParameter<int> & mainLedParam,
 		const ofParameter<int> & blendParam, const ofParameter<int> & originParam,
-		const ofParameter<int> & arcParam, const ofParameter<int> & pwmParam,
-		LedSideState & lastSent, float dt);
+		const ofParameter<int> & arcParam, float dt) const;
+	void stageLedSide(LedFrame & frame, size_t slot, const EffectParameters & params,
+		const ofParameter<int> & pwmParam, bool & refresh);
+	void emitLedSide(LedFrame & frame, size_t slot, LedMagnetController * controller, const char * oscPosition);
 
 	// Helper for minimal view
 	ofRectangle drawSingleLedControllerMinimal(float x, float y, const std::string & label,
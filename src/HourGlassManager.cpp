@@ -1,4 +1,6 @@
 #include "HourGlassManager.h"
+#include <map>
+#include <set>
 
 HourGlassManager::HourGlassManager()
 	: configFilePath("hourglasses.json")
@@ -35,10 +37,20 @@ bool HourGlassManager::loadConfiguration(const std::string & configFile) {
 		if (json.contains("baudRate")) {
 			sharedBaudRate = json["baudRate"];
 		}
+		setLedRefreshBudget(json.value("ledRefreshBytesPerSecond", DEFAULT_LED_REFRESH_BYTES_PER_SECOND));
+
+		groupOut.reset();
+		if (json.contains("groupOut")) {
+			groupOut = std::make_unique<OSCOutController>();
+			groupOut->loadConfigurationFromJson(json["groupOut"]);
+			groupOut->setMotorAck(false); // several devices would ack one sequence number
+		}
 
 		// Clear existing hourglasses
 		disconnectAll();
 		hourglasses.clear();
+		ledFrame.reset(0); // slots are laid out again on the next update()
+		effectEngine.clear();
 
 		// Load each hourglass
 
@@ -65,6 +77,10 @@ bool HourGlassManager::saveConfiguration(const std::string & configFile) {
 		ofJson json;
 		json["serialPort"] = sharedSerialPort;
 		json["baudRate"] = sharedBaudRate;
+		json["ledRefreshBytesPerSecond"] = ledRefreshBytesPerSecond;
+		if (groupOut) {
+			json["groupOut"] = { { "enabled", groupOut->isEnabled() }, { "destinations", groupOut->destinationsToJson() } };
+		}
 		json["hourglasses"] = ofJson::array();
 
 		for (const auto & hourglass : hourglasses) {
@@ -85,6 +101,8 @@ void HourGlassManager::createDefaultConfiguration() {
 	// Clear existing
 	disconnectAll();
 	hourglasses.clear();
+	ledFrame.reset(0);
+	effectEngine.clear();
 
 	// Add default hourglasses
 	addHourGlass("HourGlass1", 11, 12, 1);
@@ -105,7 +123,9 @@ bool HourGlassManager::removeHourGlass(const std::string & name) {
 
 	if (it != hourglasses.end()) {
 		(*it)->disconnect();
+		effectEngine.removeSlots(ledSlot(it - hourglasses.begin(), true), 2);
 		hourglasses.erase(it);
+		ledFrame.reset(0); // later hourglasses moved to other slots
 
 		return true;
 	}
@@ -177,20 +197,108 @@ void HourGlassManager::disableAllMotors() {
 	}
 }
 
+// The group message is only an extra path: every hourglass still gets its own
+// unicast stop, so a lost datagram or an unjoined group cannot keep a motor running
 void HourGlassManager::emergencyStopAll() {
+	sendGroupMotor(getGroupTargets(false), [](OSCOutController & out) { out.sendMotorEmergency(); });
 	for (auto & hourglass : hourglasses) {
 		hourglass->emergencyStop();
 	}
 }
 
 void HourGlassManager::setZeroAll() {
+	auto targets = getGroupTargets(true);
+	bool grouped = sendGroupMotor(targets, [](OSCOutController & out) { out.sendMotorZero(); });
+	std::set<HourGlass *> sent(targets.begin(), targets.end());
 	for (auto & hourglass : hourglasses) {
 		if (hourglass->isConnected()) {
-			hourglass->setMotorZero();
+			hourglass->setMotorZero(!(grouped && sent.count(hourglass.get())));
 		}
 	}
 }
 
+void HourGlassManager::rotateAll(float degrees, std::optional<int> speed, std::optional<int> accel) {
+	moveAll(degrees, speed, accel, false);
+}
+
+void HourGlassManager::moveAllToAngle(float degrees, std::optional<int> speed, std::optional<int> accel) {
+	moveAll(degrees, speed, accel, true);
+}
+
+// Hourglasses fall back to their own speed/acceleration, so one group message
+// per distinct (speed, accel) pair shared by at least two of them
+void HourGlassManager::moveAll(float degrees, std::optional<int> speed, std::optional<int> accel, bool absolute) {
+	std::map<std::pair<int, int>, std::vector<HourGlass *>> byArgs;
+	for (HourGlass * hourglass : getGroupTargets(true)) {
+		byArgs[{ speed.value_or(hourglass->motorSpeed.get()), accel.value_or(hourglass->motorAcceleration.get()) }].push_back(hourglass);
+	}
+
+	std::set<HourGlass *> sent;
+	for (const auto & entry : byArgs) {
+		const std::vector<HourGlass *> & targets = entry.second;
+		int groupSpeed = entry.first.first;
+		int groupAccel = entry.first.second;
+		// Device ids travel in the address prefix; 0 only passes validation
+		bool grouped = sendGroupMotor(targets, [&](OSCOutController & out) {
+			if (absolute) {
+				out.sendMotorAbsolute(0, groupSpeed, groupAccel, degrees);
+			} else {
+				out.sendMotorRelative(0, groupSpeed, groupAccel, degrees);
+			}
+		});
+		if (grouped) sent.insert(targets.begin(), targets.end());
+	}
+
+	for (auto & hourglass : hourglasses) {
+		bool sendOSC = sent.count(hourglass.get()) == 0;
+		if (absolute) {
+			hourglass->commandAbsoluteAngle(degrees, speed, accel, sendOSC);
+		} else {
+			hourglass->commandRelativeAngle(degrees, speed, accel, sendOSC);
+		}
+	}
+}
+
+// Hourglasses a group message may stand in for. Acked motor output is
+// excluded: several devices answering one sequence number would hide a loss.
+std::vector<HourGlass *> HourGlassManager::getGroupTargets(bool connectedOnly) {
+	std::vector<HourGlass *> targets;
+	if (!groupOut || !groupOut->isEnabled() || !groupOut->hasEnabledDestination()) return targets;
+	for (auto & hourglass : hourglasses) {
+		if (connectedOnly && !hourglass->isConnected()) continue;
+		if (!hourglass->isOSCOutEnabled() || hourglass->updatingFromOSC || hourglass->getOSCOut()->isMotorAckEnabled()) continue;
+		targets.push_back(hourglass.get());
+	}
+	return targets;
+}
+
+// A single hourglass is cheaper and more reliable over its own unicast path
+bool HourGlassManager::sendGroupMotor(const std::vector<HourGlass *> & targets, const std::function<void(OSCOutController &)> & send) {
+	if (targets.size() < 2) return false;
+	std::vector<int> motorIds;
+	for (HourGlass * hourglass : targets) {
+		motorIds.push_back(hourglass->getMotorId());
+	}
+	groupOut->setMotorTargets(formatMotorTargets(motorIds));
+	send(*groupOut);
+	return true;
+}
+
+std::string HourGlassManager::formatMotorTargets(std::vector<int> motorIds) {
+	std::sort(motorIds.begin(), motorIds.end());
+	motorIds.erase(std::unique(motorIds.begin(), motorIds.end()), motorIds.end());
+	std::string targets;
+	for (size_t i = 0; i < motorIds.size();) {
+		size_t end = i;
+		while (end + 1 < motorIds.size() && motorIds[end + 1] == motorIds[end] + 1) end++;
+		if (!targets.empty()) targets += ",";
+		targets += ofToString(motorIds[i]);
+		if (end > i) targets += "-" + ofToString(motorIds[end]);
+		i = end + 1;
+	}
+	return targets;
+}
+
 void HourGlassManager::refreshAllLedStates() {
 	for (auto & hourglass : hourglasses) {
 		hourglass->refreshLedState();
@@ -198,11 +306,31 @@ void HourGlassManager::refreshAllLedStates() {
 }
 
 void HourGlassManager::update(float deltaTime) {
-	for (auto & hourglass : hourglasses) {
-		hourglass->updateEffects(deltaTime);
-		if (hourglass->isConnected()) {
-			hourglass->applyLedParameters();
-			hourglass->applyMotorParameters();
+	scheduleLedRefresh(deltaTime);
+	size_t slots = hourglasses.size() * 2;
+	if (ledFrame.size() != slots) ledFrame.reset(slots);
+
+	// Base values, then every effect of the installation, pool by pool
+	effectParameters.resize(slots);
+	for (size_t i = 0; i < hourglasses.size(); i++) {
+		hourglasses[i]->getLedEffectParameters(effectParameters[i * 2], effectParameters[i * 2 + 1], deltaTime);
+	}
+	effectEngine.update();
+	effectEngine.apply(effectParameters);
+
+	for (size_t i = 0; i < hourglasses.size(); i++) {
+		if (hourglasses[i]->isConnected()) hourglasses[i]->stageLedParameters(ledFrame, i * 2, effectParameters[i * 2], effectParameters[i * 2 + 1]);
+	}
+
+	// Gamma, luminosity, clamping and change detection for every side at once.
+	// The table is held for the pass; a concurrent gamma change applies next tick.
+	auto outputTable = LedMagnetController::getOutputTable();
+	ledFrame.process(*outputTable, LedMagnetController::getGlobalLuminosity());
+
+	for (size_t i = 0; i < hourglasses.size(); i++) {
+		if (hourglasses[i]->isConnected()) {
+			hourglasses[i]->emitLedParameters(ledFrame, i * 2);
+			hourglasses[i]->applyMotorParameters();
 		}
 	}
 }
@@ -242,17 +370,11 @@ ofJson HourGlassManager::createHourGlassJson(const HourGlass & hourglass) const
 			oscConfig["enabled"] = oscOut->isEnabled();
 
 			// Save destinations
-			auto destinations = oscOut->getDestinations();
-			if (!destinations.empty()) {
-				oscConfig["destinations"] = ofJson::array();
-				for (const auto & dest : destinations) {
-					ofJson destJson;
-					destJson["name"] = dest.name;
-					destJson["ip"] = dest.ip;
-					destJson["port"] = dest.port;
-					destJson["enabled"] = dest.enabled;
-					oscConfig["destinations"].push_back(destJson);
-				}
+			if (!oscOut->getDestinations().empty()) {
+				oscConfig["destinations"] = oscOut->destinationsToJson();
+			}
+			if (oscOut->isMotorAckConfigured()) {
+				oscConfig["motorAck"] = { { "enabled", true }, { "replyPort", oscOut->getMotorAckReplyPort() } };
 			}
 
 			json["oscOut"] = oscConfig;
@@ -307,4 +429,36 @@ bool HourGlassManager::parseHourGlassJson(const ofJson & json) {
 		ofLogError("HourGlassManager") << "❌ Error parsing hourglass JSON: " << e.what();
 		return false;
 	}
-}
\ No newline at end of file
+}
+
+// Marks as many sides for refresh as the accumulated budget pays for, each at
+// most once per tick; the sends ride along in the sides' normal frame flush
+void HourGlassManager::scheduleLedRefresh(float deltaTime) {
+	if (ledRefreshBytesPerSecond <= 0 || hourglasses.empty()) {
+		ledRefreshCredit = 0.0f;
+		return;
+	}
+
+	ledRefreshCredit += ledRefreshBytesPerSecond * deltaTime;
+	size_t sides = hourglasses.size() * 2;
+	size_t nextCost = 0;
+	for (size_t visited = 0; visited < sides; visited++) {
+		size_t slot = ledRefreshCursor % sides;
+		HourGlass & hourglass = *hourglasses[slot / 2];
+		bool top = (slot % 2) == 0;
+		size_t cost = hourglass.isConnected() ? hourglass.getLedRefreshBytes(top) : 0;
+		if (static_cast<float>(cost) > ledRefreshCredit) {
+			nextCost = cost;
+			break;
+		}
+		if (cost > 0) {
+			hourglass.requestLedRefresh(top);
+			ledRefreshCredit -= static_cast<float>(cost);
+		}
+		ledRefreshCursor = slot + 1;
+	}
+
+	// Idle time does not bank a burst: keep at most one second of budget, or
+	// enough for the side that is waiting
+	ledRefreshCredit = std::min(ledRefreshCredit, static_cast<float>(std::max<size_t>(ledRefreshBytesPerSecond, nextCost)));
+}
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "EffectEngine.h"
 #include "HourGlass.h"
 #include "ofMain.h"
+#include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 class HourGlassManager {
@@ -15,7 +18,8 @@ public:
 	bool saveConfiguration(const std::string & configFile = "hourglasses.json");
 	void createDefaultConfiguration();
 
-	// Per-frame hardware tick: effects, LED sends, pending motor commands
+	// Per-frame hardware tick: effects, LED sends, pending motor commands.
+	// LED output goes through one LedFrame for the whole installation.
 	void update(float deltaTime);
 
 	// HourGlass management
@@ -36,10 +40,49 @@ public:
 	void emergencyStopAll();
 	void setZeroAll();
 	void setAllLEDs(uint8_t r, uint8_t g, uint8_t b);
+	void rotateAll(float degrees, std::optional<int> speed = std::nullopt, std::optional<int> accel = std::nullopt);
+	void moveAllToAngle(float degrees, std::optional<int> speed = std::nullopt, std::optional<int> accel = std::nullopt);
+
+	// Installation-wide motor commands go out once to the "groupOut"
+	// destinations (multicast group or subnet broadcast) in hourglasses.json,
+	// addressed to the motor ids they cover ("/1-4,7/motor/relative").
+	// Hourglasses using acked motor commands, or needing different arguments
+	// than the others, still get their own unicast message. Emergency stop is
+	// always sent unicast as well.
+	OSCOutController * getGroupOut() const { return groupOut.get(); }
+	static std::string formatMotorTargets(std::vector<int> motorIds); // "1-4,7"
+
+	// LED effects for every side. Slots as in LedFrame; removing an hourglass
+	// drops its effects and renumbers the later ones.
+	EffectEngine & getEffectEngine() { return effectEngine; }
+	static size_t ledSlot(size_t hourglassIndex, bool top) { return hourglassIndex * 2 + (top ? 0 : 1); }
+
+	// Spatial phase wave: set a copy of `effect` on the chosen sides of each
+	// hourglass in hourglassIndices, replacing their effect of that type, its
+	// phase advanced by phaseStep periods per hourglass in list order (0 keeps
+	// them in sync; 1 / count spreads one full cycle across them). Both sides
+	// of one hourglass share its phase.
+	template <typename T>
+	void setEffectWave(const std::vector<size_t> & hourglassIndices, bool top, bool bottom, T effect, float phaseStep) {
+		float phase = effect.getPhase();
+		for (size_t k = 0; k < hourglassIndices.size(); k++) {
+			effect.setPhase(phase + phaseStep * static_cast<float>(k));
+			if (top) effectEngine.set(ledSlot(hourglassIndices[k], true), effect);
+			if (bottom) effectEngine.set(ledSlot(hourglassIndices[k], false), effect);
+		}
+	}
 
 	// Invalidate all LED last-sent caches so next frame re-sends (e.g. after luminosity changes)
 	void refreshAllLedStates();
 
+	// Background full-state refresh: change-only LED output cannot recover from
+	// a lost UDP packet, so every tick re-sends whole hourglass sides
+	// round-robin, within this many bytes/s ("ledRefreshBytesPerSecond" in
+	// hourglasses.json; 0 disables)
+	void setLedRefreshBudget(int bytesPerSecond) { ledRefreshBytesPerSecond = std::max(0, bytesPerSecond); }
+	int getLedRefreshBudget() const { return ledRefreshBytesPerSecond; }
+	static constexpr int DEFAULT_LED_REFRESH_BYTES_PER_SECOND = 2048;
+
 	// Apply fn to every hourglass
 	template <typename F>
 	void forEachHourGlass(F fn) {
@@ -64,6 +107,23 @@ private:
 	std::string sharedSerialPort;
 	int sharedBaudRate;
 
+	// LED state of every side, slot = hourglass index * 2 (+ 1 bottom)
+	LedFrame ledFrame;
+	EffectEngine effectEngine;
+	std::vector<EffectParameters> effectParameters; // per slot, rebuilt every tick
+
+	// Full-state refresh pacing
+	int ledRefreshBytesPerSecond = DEFAULT_LED_REFRESH_BYTES_PER_SECOND;
+	float ledRefreshCredit = 0.0f; // bytes
+	size_t ledRefreshCursor = 0; // next side: hourglass index * 2 + (0 top, 1 bottom)
+	void scheduleLedRefresh(float deltaTime);
+
+	// Group motor output, null without a "groupOut" block
+	std::unique_ptr<OSCOutController> groupOut;
+	std::vector<HourGlass *> getGroupTargets(bool connectedOnly);
+	bool sendGroupMotor(const std::vector<HourGlass *> & targets, const std::function<void(OSCOutController &)> & send);
+	void moveAll(float degrees, std::optional<int> speed, std::optional<int> accel, bool absolute);
+
 	// JSON helpers
 	ofJson createHourGlassJson(const HourGlass & hourglass) const;
 	bool parseHourGlassJson(const ofJson & json);
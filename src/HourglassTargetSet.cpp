@@ -0,0 +1,67 @@
+#include "HourglassTargetSet.h"
+#include <charconv>
+
+namespace {
+// Parse a decimal id covering exactly [first, last)
+bool parseId(const char * first, const char * last, int & id) {
+	if (first == last) return false;
+	auto result = std::from_chars(first, last, id);
+	return result.ec == std::errc() && result.ptr == last;
+}
+}
+
+HourglassTargetSet HourglassTargetSet::parse(std::string_view expression) {
+	HourglassTargetSet set;
+	if (expression == "all") {
+		set.all = true;
+		set.valid = true;
+		return set;
+	}
+	if (expression.empty()) return set;
+
+	std::size_t pos = 0;
+	while (pos <= expression.size()) {
+		std::size_t comma = expression.find(',', pos);
+		if (comma == std::string_view::npos) comma = expression.size();
+		std::string_view item = expression.substr(pos, comma - pos);
+
+		int first = 0, last = 0;
+		std::size_t dash = item.find('-');
+		const char * begin = item.data();
+		const char * end = item.data() + item.size();
+		if (dash == std::string_view::npos) {
+			if (!parseId(begin, end, first)) return HourglassTargetSet();
+			last = first;
+		} else if (!parseId(begin, begin + dash, first) || !parseId(begin + dash + 1, end, last)) {
+			return HourglassTargetSet();
+		}
+		if (first < 1 || last > MAX_ID || first > last) return HourglassTargetSet();
+
+		set.setRange(first, last);
+		pos = comma + 1;
+	}
+
+	set.valid = true;
+	return set;
+}
+
+bool HourglassTargetSet::contains(int id) const {
+	if (!valid || id < 1 || id > MAX_ID) return false;
+	if (all) return true;
+	return (bits[(id - 1) / 64] >> ((id - 1) % 64)) & 1;
+}
+
+void HourglassTargetSet::setRange(int first, int last) {
+	for (int id = first; id <= last; id++) {
+		bits[(id - 1) / 64] |= uint64_t(1) << ((id - 1) % 64);
+	}
+}
+
+const HourglassTargetSet & HourglassTargetCache::get(std::string_view expression) {
+	auto it = cache.find(expression);
+	if (it != cache.end()) return it->second;
+
+	// A sender cycling through endless distinct expressions must not grow memory
+	if (cache.size() >= MAX_ENTRIES) cache.clear();
+	return cache.emplace(std::string(expression), HourglassTargetSet::parse(expression)).first->second;
+}
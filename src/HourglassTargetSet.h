@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+
+// Set of 1-based hourglass ids parsed from an OSC target segment:
+//   "all" | item ("," item)*   with   item = id | id "-" id
+// e.g. "3", "1,3", "1-4", "1,4-8,12". Ids outside 1..MAX_ID make the
+// expression invalid; "all" is resolved against the live hourglass count when
+// iterating, so cached sets stay correct when the installation changes.
+class HourglassTargetSet {
+public:
+	static constexpr int MAX_ID = 256;
+
+	static HourglassTargetSet parse(std::string_view expression);
+
+	bool isValid() const { return valid; }
+	bool isAll() const { return all; }
+	bool contains(int id) const;
+
+	// Calls fn(id) for every id in 1..hourglassCount, ascending; returns how many were visited
+	template <typename F>
+	int forEach(std::size_t hourglassCount, F fn) const;
+
+private:
+	static constexpr std::size_t WORDS = MAX_ID / 64;
+
+	std::array<uint64_t, WORDS> bits {}; // bit (id - 1)
+	bool all = false;
+	bool valid = false;
+
+	void setRange(int first, int last);
+	static int lowestBit(uint64_t word);
+};
+
+// Parsed target sets keyed by their raw expression. Lookups with a
+// string_view do not allocate; only first sightings are parsed and stored.
+class HourglassTargetCache {
+public:
+	static constexpr std::size_t MAX_ENTRIES = 512;
+
+	const HourglassTargetSet & get(std::string_view expression);
+	std::size_t size() const { return cache.size(); }
+	void clear() { cache.clear(); }
+
+private:
+	std::map<std::string, HourglassTargetSet, std::less<>> cache;
+};
+
+template <typename F>
+int HourglassTargetSet::forEach(std::size_t hourglassCount, F fn) const {
+	int limit = static_cast<int>(hourglassCount < static_cast<std::size_t>(MAX_ID) ? hourglassCount : MAX_ID);
+	int visited = 0;
+	if (!valid) return visited;
+
+	if (all) {
+		for (int id = 1; id <= limit; id++, visited++) {
+			fn(id);
+		}
+		return visited;
+	}
+
+	for (std::size_t w = 0; w < WORDS; w++) {
+		uint64_t word = bits[w];
+		while (word) {
+			int id = static_cast<int>(w * 64) + lowestBit(word) + 1;
+			if (id > limit) return visited;
+			fn(id);
+			visited++;
+			word &= word - 1;
+		}
+	}
+	return visited;
+}
+
+inline int HourglassTargetSet::lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(word);
+#else
+	int index = 0;
+	while (!(word & 1)) {
+		word >>= 1;
+		index++;
+	}
+	return index;
+#endif
+}
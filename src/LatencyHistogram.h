@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Log2-bucketed latency histogram in microseconds: bucket 0 counts samples
+// under 1 us, bucket i counts [2^(i-1), 2^i) us, and the last bucket
+// everything above. Recording is lock-free, so the frame thread and the
+// egress I/O thread can share one.
+class LatencyHistogram {
+public:
+	static constexpr std::size_t BUCKETS = 21; // last bucket starts at ~0.5 s
+
+	void record(uint64_t micros) {
+		std::size_t bucket = 0;
+		while (bucket + 1 < BUCKETS && (micros >> bucket) != 0) bucket++;
+		buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+		uint64_t seen = maxMicros.load(std::memory_order_relaxed);
+		while (micros > seen && !maxMicros.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {
+		}
+	}
+
+	uint64_t getCount() const {
+		uint64_t count = 0;
+		for (const auto & bucket : buckets) count += bucket.load(std::memory_order_relaxed);
+		return count;
+	}
+	uint64_t getBucket(std::size_t index) const { return buckets[index].load(std::memory_order_relaxed); }
+	uint64_t getMax() const { return maxMicros.load(std::memory_order_relaxed); }
+
+	// Upper bound (us) of the bucket holding quantile q (0-1), capped at the
+	// largest sample; 0 when empty
+	uint64_t percentile(double q) const {
+		uint64_t count = getCount();
+		if (count == 0) return 0;
+		uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+		uint64_t seen = 0;
+		for (std::size_t i = 0; i < BUCKETS; i++) {
+			seen += buckets[i].load(std::memory_order_relaxed);
+			if (seen >= rank) return i + 1 < BUCKETS ? std::min(uint64_t(1) << i, getMax()) : getMax();
+		}
+		return getMax();
+	}
+
+	void reset() {
+		for (auto & bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+		maxMicros.store(0, std::memory_order_relaxed);
+	}
+
+private:
+	std::array<std::atomic<uint64_t>, BUCKETS> buckets {};
+	std::atomic<uint64_t> maxMicros { 0 };
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "LedOutputTable.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// LED state of every hourglass side in the installation, one slot per side
+// (hourglass index * 2, + 1 for the bottom), kept as parallel arrays. Each
+// tick the hourglasses stage their effects output, process() runs gamma,
+// luminosity, clamping and change detection for all slots in a few flat
+// loops, and only slots with a change mask are sent.
+class LedFrame {
+public:
+	// Bits of getChanges(): which OSC messages a slot needs
+	enum Change : uint8_t {
+		CHANGE_RGB = 1, // /rgb: colour, origin, arc or alpha
+		CHANGE_POWER = 2, // /pwr: main LED
+		CHANGE_MAGNET = 4, // /mag: pwm
+		CHANGE_ALL = CHANGE_RGB | CHANGE_POWER | CHANGE_MAGNET
+	};
+
+	// Resize to `slots`; every slot is sent in full on its next commit
+	void reset(size_t slots) {
+		for (auto * column : { &r, &g, &b, &mainLed, &pwm, &outR, &outG, &outB, &outMainLed, &alpha,
+				 &sentR, &sentG, &sentB, &sentAlpha, &sentMainLed, &sentPwm, &changes }) {
+			column->assign(slots, 0);
+		}
+		for (auto * column : { &blend, &origin, &arc, &outBlend, &outOrigin, &outArc, &sentOrigin, &sentArc }) {
+			column->assign(slots, 0);
+		}
+		luminosity.assign(slots, 0.0f);
+		refresh.assign(slots, 1);
+	}
+	size_t size() const { return changes.size(); }
+
+	// Effects output for one side. Colour, origin and arc are what goes on the
+	// wire; luminosity is individual x effect multiplier. refresh forces a
+	// full re-send until the slot is committed.
+	void stage(size_t slot, uint8_t red, uint8_t green, uint8_t blue, int blendValue, int originValue, int arcValue,
+		float luminosityValue, uint8_t mainLedValue, uint8_t pwmValue, bool refreshSlot) {
+		r[slot] = red;
+		g[slot] = green;
+		b[slot] = blue;
+		blend[slot] = blendValue;
+		origin[slot] = originValue;
+		arc[slot] = arcValue;
+		luminosity[slot] = luminosityValue;
+		mainLed[slot] = mainLedValue;
+		pwm[slot] = pwmValue;
+		refresh[slot] |= refreshSlot ? 1 : 0;
+	}
+
+	// Output stage for every slot: gamma-corrected, luminosity-scaled device
+	// values (out*, alpha) and the change mask against the last commit. Each
+	// step is a column kernel over contiguous arrays.
+	void process(const LedOutputTable & table, float globalLuminosity) {
+		const size_t n = size();
+		scale.resize(n);
+		scaleSteps(luminosity.data(), globalLuminosity, scale.data(), n);
+
+		// Gamma and luminosity in one read of the combined table (a gather,
+		// which has no SIMD form for bytes); the rest vectorizes
+		for (auto [in, out] : { std::pair { &r, &outR }, std::pair { &g, &outG }, std::pair { &b, &outB } }) {
+			lookup(table, in->data(), scale.data(), out->data(), n);
+		}
+		scaleColumn(mainLed.data(), scale.data(), outMainLed.data(), n);
+		alphaColumn(luminosity.data(), alpha.data(), n);
+		clampColumn(blend.data(), 0, 768, outBlend.data(), n);
+		clampColumn(origin.data(), 0, 360, outOrigin.data(), n);
+		clampColumn(arc.data(), 0, 360, outArc.data(), n);
+
+		uint8_t * mask = changes.data();
+		const uint8_t * forced = refresh.data();
+		for (size_t i = 0; i < n; i++) mask[i] = static_cast<uint8_t>(forced[i] * CHANGE_ALL);
+		markChanges(r.data(), sentR.data(), CHANGE_RGB, mask, n);
+		markChanges(g.data(), sentG.data(), CHANGE_RGB, mask, n);
+		markChanges(b.data(), sentB.data(), CHANGE_RGB, mask, n);
+		markChanges(alpha.data(), sentAlpha.data(), CHANGE_RGB, mask, n);
+		markChanges(origin.data(), sentOrigin.data(), CHANGE_RGB, mask, n);
+		markChanges(arc.data(), sentArc.data(), CHANGE_RGB, mask, n);
+		markChanges(mainLed.data(), sentMainLed.data(), CHANGE_POWER, mask, n);
+		markChanges(pwm.data(), sentPwm.data(), CHANGE_MAGNET, mask, n);
+	}
+
+	uint8_t getChanges(size_t slot) const { return changes[slot]; }
+
+	// The slot's changed messages went out: remember their values
+	void commit(size_t slot) {
+		uint8_t changed = changes[slot];
+		if (changed & CHANGE_RGB) {
+			sentR[slot] = r[slot];
+			sentG[slot] = g[slot];
+			sentB[slot] = b[slot];
+			sentAlpha[slot] = alpha[slot];
+			sentOrigin[slot] = origin[slot];
+			sentArc[slot] = arc[slot];
+		}
+		if (changed & CHANGE_POWER) sentMainLed[slot] = mainLed[slot];
+		if (changed & CHANGE_MAGNET) sentPwm[slot] = pwm[slot];
+		changes[slot] = 0;
+		refresh[slot] = 0;
+	}
+
+	// Staged input
+	std::vector<uint8_t> r, g, b, mainLed, pwm;
+	std::vector<int> blend, origin, arc;
+	std::vector<float> luminosity;
+
+	// process() output: device values (gamma, global x individual luminosity,
+	// clamped) and the OSC alpha
+	std::vector<uint8_t> outR, outG, outB, outMainLed, alpha;
+	std::vector<int> outBlend, outOrigin, outArc;
+
+private:
+	// Last committed wire values
+	std::vector<uint8_t> sentR, sentG, sentB, sentAlpha, sentMainLed, sentPwm;
+	std::vector<int> sentOrigin, sentArc;
+	std::vector<uint8_t> refresh;
+	std::vector<uint8_t> changes;
+
+	// global x slot luminosity as LedOutputTable::scaleStep(), scratch for process()
+	std::vector<uint16_t> scale;
+
+	// Column kernels. __restrict (the arrays never overlap) lets the compiler
+	// vectorize without alias checks.
+	static void lookup(const LedOutputTable & table, const uint8_t * __restrict in, const uint16_t * __restrict step,
+		uint8_t * __restrict out, size_t n) {
+		for (size_t i = 0; i < n; i++) out[i] = table.scaled[step[i]][in[i]];
+	}
+	static void scaleSteps(const float * __restrict luminosity, float global, uint16_t * __restrict out, size_t n) {
+		for (size_t i = 0; i < n; i++) out[i] = LedOutputTable::scaleStep(global * luminosity[i]);
+	}
+	static void scaleColumn(const uint8_t * __restrict in, const uint16_t * __restrict step, uint8_t * __restrict out, size_t n) {
+		for (size_t i = 0; i < n; i++) out[i] = LedOutputTable::scaleLinear(in[i], step[i]);
+	}
+	static void alphaColumn(const float * __restrict in, uint8_t * __restrict out, size_t n) {
+		for (size_t i = 0; i < n; i++) out[i] = static_cast<uint8_t>(std::min(std::max(in[i] * 255.0f, 0.0f), 255.0f));
+	}
+	static void clampColumn(const int * __restrict in, int low, int high, int * __restrict out, size_t n) {
+		for (size_t i = 0; i < n; i++) out[i] = std::min(std::max(in[i], low), high);
+	}
+	template <typename T>
+	static void markChanges(const T * __restrict current, const T * __restrict last, uint8_t bit, uint8_t * __restrict mask, size_t n) {
+		for (size_t i = 0; i < n; i++) mask[i] |= static_cast<uint8_t>((current[i] != last[i]) * bit);
+	}
+};
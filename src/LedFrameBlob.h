@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Wire format of the /system/frame blob (all multi-byte fields big-endian).
+// See docs/OSC_API_Documentation.md, "Packed frame".
+//
+//   header (6 bytes)  u8 version (= 1), u8 flags (0), u16 count, u16 firstId
+//   record (24 bytes, one per hourglass, ids firstId .. firstId + count - 1)
+//     u8 luminosity (individual, 0-255 -> 0.0-1.0), u8 reserved
+//     up side, then down side (11 bytes each):
+//       u8 r, u8 g, u8 b, u8 mainLed, u8 pwm, u16 blend, u16 origin, u16 arc
+namespace LedFrameBlob {
+
+constexpr uint8_t VERSION = 1;
+constexpr std::size_t HEADER_SIZE = 6;
+constexpr std::size_t SIDE_SIZE = 11;
+constexpr std::size_t RECORD_SIZE = 2 + 2 * SIDE_SIZE;
+
+struct Header {
+	uint8_t version = 0;
+	uint8_t flags = 0;
+	uint16_t count = 0;
+	uint16_t firstId = 0;
+};
+
+struct Side {
+	uint8_t r = 0, g = 0, b = 0;
+	uint8_t mainLed = 0;
+	uint8_t pwm = 0;
+	uint16_t blend = 0;
+	uint16_t origin = 0;
+	uint16_t arc = 0;
+};
+
+struct Record {
+	uint8_t luminosity = 255;
+	Side up;
+	Side down;
+};
+
+inline uint16_t readU16(const uint8_t * p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+inline void writeU16(uint8_t * p, uint16_t v) {
+	p[0] = static_cast<uint8_t>(v >> 8);
+	p[1] = static_cast<uint8_t>(v & 0xFF);
+}
+
+inline Header readHeader(const uint8_t * p) {
+	Header header;
+	header.version = p[0];
+	header.flags = p[1];
+	header.count = readU16(p + 2);
+	header.firstId = readU16(p + 4);
+	return header;
+}
+
+inline void writeHeader(uint8_t * p, const Header & header) {
+	p[0] = header.version;
+	p[1] = header.flags;
+	writeU16(p + 2, header.count);
+	writeU16(p + 4, header.firstId);
+}
+
+inline Side readSide(const uint8_t * p) {
+	Side side;
+	side.r = p[0];
+	side.g = p[1];
+	side.b = p[2];
+	side.mainLed = p[3];
+	side.pwm = p[4];
+	side.blend = readU16(p + 5);
+	side.origin = readU16(p + 7);
+	side.arc = readU16(p + 9);
+	return side;
+}
+
+inline void writeSide(uint8_t * p, const Side & side) {
+	p[0] = side.r;
+	p[1] = side.g;
+	p[2] = side.b;
+	p[3] = side.mainLed;
+	p[4] = side.pwm;
+	writeU16(p + 5, side.blend);
+	writeU16(p + 7, side.origin);
+	writeU16(p + 9, side.arc);
+}
+
+inline Record readRecord(const uint8_t * p) {
+	Record record;
+	record.luminosity = p[0];
+	record.up = readSide(p + 2);
+	record.down = readSide(p + 2 + SIDE_SIZE);
+	return record;
+}
+
+inline void writeRecord(uint8_t * p, const Record & record) {
+	p[0] = record.luminosity;
+	p[1] = 0;
+	writeSide(p + 2, record.up);
+	writeSide(p + 2 + SIDE_SIZE, record.down);
+}
+
+// Expected blob size for a header, or 0 when the header cannot be decoded
+inline std::size_t expectedSize(const Header & header) {
+	if (header.version != VERSION) return 0;
+	return HEADER_SIZE + static_cast<std::size_t>(header.count) * RECORD_SIZE;
+}
+
+} // namespace LedFrameBlob
@@ -1,7 +1,9 @@
 #include "LedMagnetController.h"
 
 // Initialize static members
-float LedMagnetController::globalLuminosityValue = 1.0f; // Default to full brightness
+std::atomic<float> LedMagnetController::globalLuminosityValue { 1.0f }; // Default to full brightness
+std::shared_ptr<const LedOutputTable> LedMagnetController::outputTable = LedOutputTable::build(2.2f, 3);
+std::mutex LedMagnetController::outputTableMutex;
 
 LedMagnetController::LedMagnetController()
 	: lastSentRGB(0, 0, 0)
@@ -78,7 +80,7 @@ LedMagnetController & LedMagnetController::setRemote(bool remote) {
 // Global Luminosity Static Methods
 void LedMagnetController::setGlobalLuminosity(float luminosity) {
 	globalLuminosityValue = ofClamp(luminosity, 0.0f, 1.0f);
-	ofLogNotice("LedMagnetController") << "Global luminosity set to: " << globalLuminosityValue;
+	ofLogNotice("LedMagnetController") << "Global luminosity set to: " << globalLuminosityValue.load();
 }
 
 float LedMagnetController::getGlobalLuminosity() {
@@ -92,7 +94,8 @@ void LedMagnetController::resetLastSentValues() {
 }
 
 LedMagnetController & LedMagnetController::sendLED(uint8_t value, float individualLuminosityFactor) { // Main LED
-	uint8_t modulatedValue = static_cast<uint8_t>(ofClamp(static_cast<float>(value) * globalLuminosityValue * individualLuminosityFactor, 0.0f, 255.0f));
+	uint16_t step = LedOutputTable::scaleStep(globalLuminosityValue * individualLuminosityFactor);
+	uint8_t modulatedValue = LedOutputTable::scaleLinear(value, step);
 
 	if (mainLedInitialized && modulatedValue == lastSentMainLED) {
 		return *this;
@@ -105,14 +108,12 @@ LedMagnetController & LedMagnetController::sendLED(uint8_t value, float individu
 }
 
 LedMagnetController & LedMagnetController::sendLED(uint8_t r, uint8_t g, uint8_t b, int blend, int origin, int arc, float individualLuminosityFactor, bool enabled) { // RGB LED
-	uint8_t optR = optimizeRGB(r);
-	uint8_t optG = optimizeRGB(g);
-	uint8_t optB = optimizeRGB(b);
-
-	// Apply global AND individual luminosity
-	uint8_t finalR = static_cast<uint8_t>(ofClamp(static_cast<float>(optR) * globalLuminosityValue * individualLuminosityFactor, 0.0f, 255.0f));
-	uint8_t finalG = static_cast<uint8_t>(ofClamp(static_cast<float>(optG) * globalLuminosityValue * individualLuminosityFactor, 0.0f, 255.0f));
-	uint8_t finalB = static_cast<uint8_t>(ofClamp(static_cast<float>(optB) * globalLuminosityValue * individualLuminosityFactor, 0.0f, 255.0f));
+	// Gamma with global AND individual luminosity: one table read per channel
+	auto table = getOutputTable();
+	const uint8_t * row = table->row(LedOutputTable::scaleStep(globalLuminosityValue * individualLuminosityFactor));
+	uint8_t finalR = row[r];
+	uint8_t finalG = row[g];
+	uint8_t finalB = row[b];
 
 	// Clamp the new parameters according to JavaScript implementation
 	int clampedBlend = ofClamp(blend, 0, 768);
@@ -150,6 +151,18 @@ LedMagnetController & LedMagnetController::sendLED(uint8_t r, uint8_t g, uint8_t
 	return *this;
 }
 
+void LedMagnetController::setOutputState(const ofColor & rgb, int blend, int origin, int arc, uint8_t mainLed, uint8_t pwm) {
+	lastSentRGB = rgb;
+	lastSentBlend = blend;
+	lastSentOrigin = origin;
+	lastSentArc = arc;
+	lastSentMainLED = mainLed;
+	lastSentPWM = pwm;
+	rgbInitialized = true;
+	mainLedInitialized = true;
+	pwmInitialized = true;
+}
+
 LedMagnetController & LedMagnetController::sendPWM(uint8_t value) { // PWM not affected by global luminosity
 	if (pwmInitialized && value == lastSentPWM) {
 		return *this;
@@ -165,45 +178,26 @@ bool LedMagnetController::send(const std::vector<uint8_t> & data) {
 	return true;
 }
 
-// RGB optimization static variables
-uint8_t LedMagnetController::gammaLUT[256];
-float LedMagnetController::currentGamma = 2.2f;
-uint8_t LedMagnetController::minThreshold = 3;
-bool LedMagnetController::lutInitialized = false;
-
-void LedMagnetController::initializeLUT() {
-	for (int i = 0; i < 256; i++) {
-		if (i == 0) {
-			gammaLUT[i] = 0;
-		} else {
-			float normalized = i / 255.0f;
-			float corrected = pow(normalized, 1.0f / currentGamma);
-			uint8_t gammaValue = (uint8_t)(corrected * 255.0f);
-
-			if (gammaValue > 0 && gammaValue < minThreshold) {
-				gammaValue = minThreshold;
-			}
-			gammaLUT[i] = gammaValue;
-		}
-	}
-	lutInitialized = true;
+std::shared_ptr<const LedOutputTable> LedMagnetController::getOutputTable() {
+	return std::atomic_load(&outputTable);
 }
 
 uint8_t LedMagnetController::optimizeRGB(uint8_t value) {
-	if (!lutInitialized) {
-		initializeLUT();
-	}
-	return gammaLUT[value];
+	return getOutputTable()->gamma[value];
 }
 
 void LedMagnetController::setGammaCorrection(float gamma) {
-	currentGamma = gamma;
-	lutInitialized = false;
+	if (gamma <= 0.0f) {
+		ofLogWarning("LedMagnetController") << "Ignoring gamma " << gamma << " (must be > 0)";
+		return;
+	}
+	std::lock_guard<std::mutex> lock(outputTableMutex);
+	std::atomic_store(&outputTable, LedOutputTable::build(gamma, getOutputTable()->minThreshold));
 }
 
 void LedMagnetController::setMinimumThreshold(uint8_t threshold) {
-	minThreshold = threshold;
-	lutInitialized = false;
+	std::lock_guard<std::mutex> lock(outputTableMutex);
+	std::atomic_store(&outputTable, LedOutputTable::build(getOutputTable()->gammaValue, threshold));
 }
 
 // LED Circle System Helper Functions
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "LedOutputTable.h"
 #include "ofMain.h"
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -47,10 +50,12 @@ public:
 		uint8_t mainLedValue, uint8_t pwmValue,
 		float individualLuminosityFactor = 1.0f);
 
-	// RGB optimization for better low-value performance
+	// RGB optimization for better low-value performance. Setting gamma or the
+	// threshold builds a new output table and swaps it in; safe from any thread.
 	static uint8_t optimizeRGB(uint8_t value);
 	static void setGammaCorrection(float gamma);
 	static void setMinimumThreshold(uint8_t threshold);
+	static std::shared_ptr<const LedOutputTable> getOutputTable();
 
 	// Global Luminosity Control (static)
 	static void setGlobalLuminosity(float luminosity);
@@ -72,6 +77,9 @@ public:
 	int getLastSentOrigin() const { return lastSentOrigin; }
 	int getLastSentArc() const { return lastSentArc; }
 
+	// Device values computed for the whole installation by LedFrame::process()
+	void setOutputState(const ofColor & rgb, int blend, int origin, int arc, uint8_t mainLed, uint8_t pwm);
+
 	bool isRgbInitialized() const { return rgbInitialized; }
 	bool isMainLedInitialized() const { return mainLedInitialized; }
 	bool isPwmInitialized() const { return pwmInitialized; }
@@ -87,12 +95,6 @@ public:
 	bool mainLedInitialized = false;
 	bool pwmInitialized = false;
 
-	// RGB optimization static variables
-	static uint8_t gammaLUT[256];
-	static float currentGamma;
-	static uint8_t minThreshold;
-	static bool lutInitialized;
-
 	// LED Circle System Constants
 	static const int CIRCLE_1_BLEND = 0; // Inner circle (32 LEDs)
 	static const int CIRCLE_2_BLEND = 384; // Middle circle (36 LEDs) - scaled to 768 range
@@ -103,9 +105,6 @@ public:
 	static int calculateBlendTransition(int fromCircle, int toCircle, float progress); // 0.0-1.0
 	static bool isArcActive(int currentAngle, int origin, int arcEnd);
 
-	// RGB optimization methods
-	static void initializeLUT();
-
 	// Invalidate luminosity-modulated caches (rgb + main LED) so next send re-transmits
 	void resetLastSentValues();
 
@@ -118,5 +117,9 @@ private:
 	bool rtr = false;
 
 	// Global luminosity static data
-	static float globalLuminosityValue;
+	static std::atomic<float> globalLuminosityValue;
+
+	// Current gamma + luminosity table; only accessed through std::atomic_load/atomic_store
+	static std::shared_ptr<const LedOutputTable> outputTable;
+	static std::mutex outputTableMutex; // serializes rebuilds
 };
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+// Gamma-corrected, luminosity-scaled 8-bit LED output for every input value
+// at every luminosity step, so producing a channel is one table read:
+// row(scaleStep(luminosity))[value]. Luminosity (global x individual) is
+// quantized to 1/256 steps, giving 257 rows of 256 entries (~64 KB).
+// Immutable once built: LedMagnetController builds a new table when gamma or
+// the threshold change and swaps it in atomically, so readers on any thread
+// only ever see a complete table.
+struct LedOutputTable {
+	static constexpr int SCALE_STEPS = 256;
+
+	float gammaValue = 2.2f;
+	uint8_t minThreshold = 3;
+	uint8_t gamma[256]; // unscaled: gamma curve with the low-value threshold
+	uint8_t scaled[SCALE_STEPS + 1][256];
+
+	static uint16_t scaleStep(float luminosity) {
+		return static_cast<uint16_t>(std::min(std::max(luminosity, 0.0f), 1.0f) * SCALE_STEPS + 0.5f);
+	}
+	const uint8_t * row(uint16_t step) const { return scaled[step]; }
+
+	// Linear (not gamma-corrected) channel, e.g. the main LED
+	static uint8_t scaleLinear(uint8_t value, uint16_t step) {
+		return static_cast<uint8_t>(std::min((value * step) / SCALE_STEPS, 255));
+	}
+
+	static std::shared_ptr<const LedOutputTable> build(float gammaValue, uint8_t minThreshold) {
+		auto table = std::make_shared<LedOutputTable>();
+		table->gammaValue = gammaValue;
+		table->minThreshold = minThreshold;
+		table->gamma[0] = 0;
+		for (int i = 1; i < 256; i++) {
+			float corrected = std::pow(i / 255.0f, 1.0f / gammaValue);
+			uint8_t value = static_cast<uint8_t>(corrected * 255.0f);
+			if (value > 0 && value < minThreshold) value = minThreshold;
+			table->gamma[i] = value;
+		}
+		for (int step = 0; step <= SCALE_STEPS; step++) {
+			for (int i = 0; i < 256; i++) table->scaled[step][i] = scaleLinear(table->gamma[i], static_cast<uint16_t>(step));
+		}
+		return table;
+	}
+};
@@ -0,0 +1,87 @@
+#include "LedParameterStage.h"
+#include "HourGlassManager.h"
+
+void LedParameterStage::stage(size_t hourglassIndex, Side side, Field field, int value) {
+	size_t index = hourglassIndex * SLOTS_PER_HOURGLASS + side * FIELD_COUNT + field;
+	if (index >= slots.size()) {
+		// Grows only when the installation does; steady state never allocates
+		slots.resize((hourglassIndex + 1) * SLOTS_PER_HOURGLASS);
+		pending.reserve(slots.size());
+	}
+
+	Slot & slot = slots[index];
+	slot.value = value;
+	if (!slot.isPending) {
+		slot.isPending = true;
+		pending.push_back(static_cast<uint32_t>(index));
+	}
+	stats.staged++;
+}
+
+void LedParameterStage::stageColor(size_t hourglassIndex, Side side, const ofColor & color) {
+	stage(hourglassIndex, side, COLOR, packColor(color));
+}
+
+size_t LedParameterStage::commit(HourGlassManager & manager) {
+	size_t committed = 0;
+
+	for (uint32_t index : pending) {
+		Slot & slot = slots[index];
+		slot.isPending = false;
+
+		HourGlass * hg = manager.getHourGlass(index / SLOTS_PER_HOURGLASS);
+		if (!hg) continue; // hourglass removed since the value was staged
+
+		Side side = static_cast<Side>((index % SLOTS_PER_HOURGLASS) / FIELD_COUNT);
+		Field field = static_cast<Field>(index % FIELD_COUNT);
+
+		hg->updatingFromOSC = true;
+		if (field == COLOR) {
+			ofParameter<ofColor> & param = side == UP ? hg->upLedColor : hg->downLedColor;
+			ofColor color = unpackColor(slot.value);
+			if (param.get() != color) {
+				param.set(color);
+				committed++;
+			} else {
+				stats.unchanged++;
+			}
+		} else {
+			ofParameter<int> & param = *intParameter(*hg, side, field);
+			if (param.get() != slot.value) {
+				param.set(slot.value);
+				committed++;
+			} else {
+				stats.unchanged++;
+			}
+		}
+		hg->updatingFromOSC = false;
+	}
+
+	pending.clear();
+	stats.committed += committed;
+	return committed;
+}
+
+void LedParameterStage::clear() {
+	for (uint32_t index : pending) {
+		slots[index].isPending = false;
+	}
+	pending.clear();
+}
+
+ofParameter<int> * LedParameterStage::intParameter(HourGlass & hg, Side side, Field field) {
+	bool up = (side == UP);
+	switch (field) {
+	case MAIN_LED:
+		return up ? &hg.upMainLed : &hg.downMainLed;
+	case PWM:
+		return up ? &hg.upPwm : &hg.downPwm;
+	case BLEND:
+		return up ? &hg.upLedBlend : &hg.downLedBlend;
+	case ORIGIN:
+		return up ? &hg.upLedOrigin : &hg.downLedOrigin;
+	case ARC:
+	default:
+		return up ? &hg.upLedArc : &hg.downLedArc;
+	}
+}
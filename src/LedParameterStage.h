@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ofMain.h"
+#include <cstdint>
+#include <vector>
+
+class HourGlass;
+class HourGlassManager;
+
+// Per-tick staging for OSC-driven LED parameters, keyed by (hourglass, side, field).
+// Handlers only record the latest value; commit() then sets each changed
+// ofParameter once, so a fader sweep of N messages in one frame fires the
+// UI listeners once instead of N times. Motor commands do not go through here.
+class LedParameterStage {
+public:
+	enum Side {
+		UP = 0,
+		DOWN,
+		SIDE_COUNT
+	};
+	enum Field {
+		COLOR = 0,
+		MAIN_LED,
+		PWM,
+		BLEND,
+		ORIGIN,
+		ARC,
+		FIELD_COUNT
+	};
+
+	struct Stats {
+		uint64_t staged = 0; // values recorded by handlers
+		uint64_t committed = 0; // ofParameter::set calls issued
+		uint64_t unchanged = 0; // pending values equal to the current parameter
+	};
+
+	// hourglassIndex is 0-based (OSC id - 1)
+	void stage(size_t hourglassIndex, Side side, Field field, int value);
+	void stageColor(size_t hourglassIndex, Side side, const ofColor & color);
+
+	// Apply pending values to the hourglass parameters; returns the number set
+	size_t commit(HourGlassManager & manager);
+	void clear();
+
+	size_t getPendingCount() const { return pending.size(); }
+	const Stats & getStats() const { return stats; }
+
+private:
+	struct Slot {
+		int value = 0;
+		bool isPending = false;
+	};
+	std::vector<Slot> slots;
+	std::vector<uint32_t> pending; // slot indices in first-staged order
+	Stats stats;
+
+	static constexpr size_t SLOTS_PER_HOURGLASS = SIDE_COUNT * FIELD_COUNT;
+
+	static int packColor(const ofColor & color) { return (color.r << 16) | (color.g << 8) | color.b; }
+	static ofColor unpackColor(int value) { return ofColor((value >> 16) & 0xFF, (value >> 8) & 0xFF, value & 0xFF); }
+	static ofParameter<int> * intParameter(HourGlass & hg, Side side, Field field);
+};
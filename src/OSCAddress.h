@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+// Non-owning view of an OSC address split on '/'. Segments point into the
+// original address string, so splitting never allocates; empty segments are
+// skipped like ofSplitString(address, "/", true). The address string must
+// outlive the view.
+class OSCAddress {
+public:
+	static constexpr std::size_t MAX_SEGMENTS = 16;
+
+	OSCAddress() = default;
+	explicit OSCAddress(std::string_view address) { parse(address); }
+
+	// Returns false when the address has more than MAX_SEGMENTS segments
+	bool parse(std::string_view address) {
+		full = address;
+		count = 0;
+		std::size_t pos = 0;
+		while (pos < address.size()) {
+			std::size_t next = address.find('/', pos);
+			if (next == std::string_view::npos) next = address.size();
+			if (next > pos) {
+				if (count == MAX_SEGMENTS) return false;
+				segments[count++] = address.substr(pos, next - pos);
+			}
+			pos = next + 1;
+		}
+		return true;
+	}
+
+	std::size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	std::string_view operator[](std::size_t index) const { return segments[index]; }
+	std::string_view str() const { return full; }
+
+	// Leading integer of a segment (std::stoi semantics, without the exception)
+	bool toInt(std::size_t index, int & out) const {
+		if (index >= count) return false;
+		std::string_view s = segments[index];
+		const char * first = s.data();
+		const char * last = s.data() + s.size();
+		if (first != last && *first == '+') ++first;
+		return std::from_chars(first, last, out).ec == std::errc();
+	}
+
+	// Leading float of a segment (std::stof semantics, without the exception)
+	bool toFloat(std::size_t index, float & out) const {
+		if (index >= count) return false;
+		std::string_view s = segments[index];
+		char buffer[32];
+		if (s.empty() || s.size() >= sizeof(buffer)) return false;
+		std::memcpy(buffer, s.data(), s.size());
+		buffer[s.size()] = '\0';
+		char * end = nullptr;
+		out = std::strtof(buffer, &end);
+		return end != buffer;
+	}
+
+private:
+	std::string_view full;
+	std::array<std::string_view, MAX_SEGMENTS> segments {};
+	std::size_t count = 0;
+};
@@ -0,0 +1,64 @@
+#include "OSCBundleScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+namespace {
+// Seconds between the NTP epoch (1900) and the Unix epoch (1970)
+constexpr uint64_t NTP_UNIX_OFFSET_SECONDS = 2208988800ULL;
+}
+
+uint64_t OSCBundleScheduler::timetagToSteadyMicros(uint64_t timetag, uint64_t nowSteadyMicros) {
+	uint64_t seconds = timetag >> 32;
+	uint64_t fraction = timetag & 0xFFFFFFFFULL;
+	if (seconds < NTP_UNIX_OFFSET_SECONDS) return 0;
+
+	int64_t timetagMicros = static_cast<int64_t>((seconds - NTP_UNIX_OFFSET_SECONDS) * 1000000ULL + ((fraction * 1000000ULL) >> 32));
+	auto wallSinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+	int64_t wallMicros = std::chrono::duration_cast<std::chrono::microseconds>(wallSinceEpoch).count();
+
+	int64_t due = static_cast<int64_t>(nowSteadyMicros) + (timetagMicros - wallMicros);
+	return due > 0 ? static_cast<uint64_t>(due) : 0;
+}
+
+bool OSCBundleScheduler::schedule(uint64_t dueMicros, const char * data, std::size_t size) {
+	if (heap.size() >= MAX_PENDING) {
+		stats.dropped++;
+		return false;
+	}
+
+	std::vector<char> bytes;
+	if (!spareBuffers.empty()) {
+		bytes.swap(spareBuffers.back());
+		spareBuffers.pop_back();
+	}
+	bytes.assign(data, data + size);
+
+	heap.push_back({ dueMicros, nextSequence++, std::move(bytes) });
+	std::push_heap(heap.begin(), heap.end(), Later());
+	stats.scheduled++;
+	return true;
+}
+
+void OSCBundleScheduler::popEarliest(std::vector<char> & out, uint64_t & dueMicros) {
+	std::pop_heap(heap.begin(), heap.end(), Later());
+	Entry & entry = heap.back();
+	dueMicros = entry.dueMicros;
+	out.swap(entry.bytes);
+	spareBuffers.push_back(std::move(entry.bytes)); // previous 'out' buffer, kept for reuse
+	heap.pop_back();
+}
+
+void OSCBundleScheduler::recordLateness(int64_t latenessMicros) {
+	stats.applied++;
+	stats.lastLatenessMicros = latenessMicros;
+	stats.maxLatenessMicros = std::max(stats.maxLatenessMicros, latenessMicros);
+	stats.meanAbsLatenessMicros += (std::abs(static_cast<double>(latenessMicros)) - stats.meanAbsLatenessMicros) / static_cast<double>(stats.applied);
+}
+
+void OSCBundleScheduler::clear() {
+	for (Entry & entry : heap) {
+		spareBuffers.push_back(std::move(entry.bytes));
+	}
+	heap.clear();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Holds OSC bundles whose timetag lies in the future and releases them on the
+// tick closest to their due time. Entries are raw bundle bytes ordered by due
+// time (steady clock, microseconds) in a binary min-heap; buffers are recycled
+// so a steady cue stream does not allocate.
+class OSCBundleScheduler {
+public:
+	static constexpr std::size_t MAX_PENDING = 1024;
+	static constexpr uint64_t IMMEDIATE_TIMETAG = 1; // OSC "execute now"
+
+	struct Stats {
+		uint64_t scheduled = 0; // future bundles accepted
+		uint64_t dropped = 0; // rejected because MAX_PENDING was reached
+		uint64_t expired = 0; // timetag already past on arrival (run at once)
+		uint64_t applied = 0; // scheduled bundles released
+		int64_t lastLatenessMicros = 0; // release time - due time (negative = early)
+		int64_t maxLatenessMicros = 0;
+		double meanAbsLatenessMicros = 0.0;
+	};
+
+	// Convert an OSC (NTP) timetag to the steady clock, using the current
+	// wall-clock/steady-clock offset. Past timetags yield values <= nowSteadyMicros.
+	static uint64_t timetagToSteadyMicros(uint64_t timetag, uint64_t nowSteadyMicros);
+
+	bool schedule(uint64_t dueMicros, const char * data, std::size_t size);
+	void noteExpired() { stats.expired++; }
+
+	// Release every bundle due before now + horizonMicros, earliest first.
+	// dispatch(const char * data, std::size_t size) may schedule again.
+	template <typename Dispatch>
+	std::size_t runDue(uint64_t nowMicros, uint64_t horizonMicros, Dispatch dispatch);
+
+	void clear();
+	std::size_t size() const { return heap.size(); }
+	bool empty() const { return heap.empty(); }
+	// Due time of the earliest pending bundle (0 when empty)
+	uint64_t nextDueMicros() const { return heap.empty() ? 0 : heap.front().dueMicros; }
+	const Stats & getStats() const { return stats; }
+
+private:
+	struct Entry {
+		uint64_t dueMicros;
+		uint64_t sequence; // FIFO among equal due times
+		std::vector<char> bytes;
+	};
+	struct Later {
+		bool operator()(const Entry & a, const Entry & b) const {
+			return a.dueMicros != b.dueMicros ? a.dueMicros > b.dueMicros : a.sequence > b.sequence;
+		}
+	};
+
+	std::vector<Entry> heap;
+	std::vector<std::vector<char>> spareBuffers;
+	std::vector<char> releasing;
+	uint64_t nextSequence = 0;
+	Stats stats;
+
+	void popEarliest(std::vector<char> & out, uint64_t & dueMicros);
+	void recordLateness(int64_t latenessMicros);
+};
+
+template <typename Dispatch>
+std::size_t OSCBundleScheduler::runDue(uint64_t nowMicros, uint64_t horizonMicros, Dispatch dispatch) {
+	std::size_t released = 0;
+	while (!heap.empty() && heap.front().dueMicros <= nowMicros + horizonMicros) {
+		uint64_t dueMicros = 0;
+		popEarliest(releasing, dueMicros);
+		recordLateness(static_cast<int64_t>(nowMicros) - static_cast<int64_t>(dueMicros));
+		dispatch(releasing.data(), releasing.size());
+		released++;
+	}
+	return released;
+}
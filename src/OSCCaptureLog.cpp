@@ -0,0 +1,96 @@
+#include "OSCCaptureLog.h"
+#include <cstring>
+
+namespace {
+const char MAGIC[6] = { 'M', 'Y', 'R', 'O', 'S', 'C' };
+
+void putLE(unsigned char * p, uint64_t value, int bytes) {
+	for (int i = 0; i < bytes; i++) {
+		p[i] = static_cast<unsigned char>(value >> (8 * i));
+	}
+}
+
+uint64_t getLE(const char * p, int bytes) {
+	uint64_t value = 0;
+	for (int i = 0; i < bytes; i++) {
+		value |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+	}
+	return value;
+}
+}
+
+bool OSCCaptureLog::open(const std::string & filePath) {
+	close();
+	file = std::fopen(filePath.c_str(), "wb");
+	if (!file) return false;
+
+	unsigned char header[HEADER_SIZE] = {};
+	std::memcpy(header, MAGIC, sizeof(MAGIC));
+	header[6] = VERSION;
+	if (std::fwrite(header, 1, HEADER_SIZE, file) != HEADER_SIZE) {
+		close();
+		return false;
+	}
+	path = filePath;
+	writtenCount = 0;
+	return true;
+}
+
+bool OSCCaptureLog::write(uint64_t arrivalMicros, const char * data, uint32_t size) {
+	if (!file) return false;
+
+	unsigned char recordHeader[RECORD_HEADER_SIZE];
+	putLE(recordHeader, arrivalMicros, 8);
+	putLE(recordHeader + 8, size, 4);
+	if (std::fwrite(recordHeader, 1, RECORD_HEADER_SIZE, file) != RECORD_HEADER_SIZE
+		|| std::fwrite(data, 1, size, file) != size) {
+		return false;
+	}
+	writtenCount++;
+	return true;
+}
+
+void OSCCaptureLog::close() {
+	if (file) {
+		std::fclose(file);
+		file = nullptr;
+	}
+}
+
+bool OSCCaptureLog::load(const std::string & filePath, std::vector<char> & bytes, std::vector<Record> & records, std::string & error) {
+	bytes.clear();
+	records.clear();
+
+	std::FILE * in = std::fopen(filePath.c_str(), "rb");
+	if (!in) {
+		error = "cannot open " + filePath;
+		return false;
+	}
+	char chunk[65536];
+	std::size_t n = 0;
+	while ((n = std::fread(chunk, 1, sizeof(chunk), in)) > 0) {
+		bytes.insert(bytes.end(), chunk, chunk + n);
+	}
+	std::fclose(in);
+
+	if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0) {
+		error = "not an OSC capture log";
+		return false;
+	}
+	if (static_cast<uint8_t>(bytes[6]) != VERSION) {
+		error = "unsupported capture version " + std::to_string(static_cast<uint8_t>(bytes[6]));
+		return false;
+	}
+
+	std::size_t pos = HEADER_SIZE;
+	while (pos + RECORD_HEADER_SIZE <= bytes.size()) {
+		Record record;
+		record.arrivalMicros = getLE(bytes.data() + pos, 8);
+		record.size = static_cast<uint32_t>(getLE(bytes.data() + pos + 8, 4));
+		record.offset = pos + RECORD_HEADER_SIZE;
+		if (record.offset + record.size > bytes.size()) break; // truncated tail (recording interrupted)
+		records.push_back(record);
+		pos = record.offset + record.size;
+	}
+	return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Binary log of received OSC datagrams, for replaying real show traffic.
+//
+//   file header  "MYROSC" (6 bytes), u8 version (= 1), u8 reserved
+//   record       u64 arrivalMicros, u32 size, size bytes of raw OSC packet
+//
+// Integers are little-endian. arrivalMicros is the receive thread's steady
+// clock; only differences between records are meaningful.
+class OSCCaptureLog {
+public:
+	static constexpr uint8_t VERSION = 1;
+	static constexpr std::size_t HEADER_SIZE = 8;
+	static constexpr std::size_t RECORD_HEADER_SIZE = 12;
+
+	struct Record {
+		uint64_t arrivalMicros;
+		std::size_t offset; // into the loaded byte buffer
+		uint32_t size;
+	};
+
+	OSCCaptureLog() = default;
+	~OSCCaptureLog() { close(); }
+	OSCCaptureLog(const OSCCaptureLog &) = delete;
+	OSCCaptureLog & operator=(const OSCCaptureLog &) = delete;
+
+	// Recording
+	bool open(const std::string & path);
+	bool write(uint64_t arrivalMicros, const char * data, uint32_t size);
+	void close();
+	bool isOpen() const { return file != nullptr; }
+	uint64_t getWrittenCount() const { return writtenCount; }
+	const std::string & getPath() const { return path; }
+
+	// Reading: the whole log is loaded; records index into bytes
+	static bool load(const std::string & path, std::vector<char> & bytes, std::vector<Record> & records, std::string & error);
+
+private:
+	std::FILE * file = nullptr;
+	std::string path;
+	uint64_t writtenCount = 0;
+};
@@ -1,5 +1,9 @@
 #include "OSCController.h"
+#include "LedFrameBlob.h"
+#include "OSCEgressService.h"
 #include "OSCHelper.h"
+#include "OscOutboundPacketStream.h"
+#include "OscReceivedElements.h"
 #include "UIWrapper.h"
 #include "ofMain.h"
 
@@ -9,16 +13,19 @@ OSCController::OSCController(HourGlassManager * manager)
 	, oscEnabled(false)
 	, receivePort(8000) {
 
+	OSCHelper::setErrorLog(&errorLog);
 	loadMotorPresets(); // Load presets on construction
+	buildRoutes();
 }
 
 OSCController::~OSCController() {
 	shutdown();
+	OSCHelper::clearErrorLog(&errorLog);
 }
 
 void OSCController::setup(int receivePort) {
 	this->receivePort = receivePort;
-	receiver.setup(receivePort);
+	receiveThread.start(receivePort);
 
 	oscEnabled = true;
 }
@@ -26,100 +33,353 @@ void OSCController::setup(int receivePort) {
 void OSCController::update() {
 	if (!oscEnabled) return;
 
-	while (receiver.hasWaitingMessages()) {
-		ofxOscMessage message;
-		receiver.getNextMessage(message);
-		processMessage(message);
+	// Track the tick period so timed bundles land on the closest tick
+	uint64_t now = OSCReceiveThread::nowMicros();
+	if (lastUpdateMicros > 0) {
+		tickPeriodMicros = (tickPeriodMicros * 7 + (now - lastUpdateMicros)) / 8;
 	}
+	lastUpdateMicros = now;
+
+	// Timed bundles due on this tick, earliest first
+	bundleScheduler.runDue(now, tickPeriodMicros / 2, [this](const char * data, std::size_t size) {
+		dispatchPacket(data, size);
+	});
+
+	// Drain everything the receive thread queued since the last frame
+	auto & queue = receiveThread.getQueue();
+	while (OSCPacket * packet = queue.front()) {
+		lastQueueDelayMicros = OSCReceiveThread::nowMicros() - packet->arrivalMicros;
+		maxQueueDelayMicros = std::max(maxQueueDelayMicros, lastQueueDelayMicros);
+
+		if (captureLog.isOpen() && !captureLog.write(packet->arrivalMicros, packet->data, packet->size)) {
+			ofLogError("OSCController") << "Capture write failed, stopping capture to " << captureLog.getPath();
+			stopCapture();
+		}
+
+		currentArrivalMicros = packet->arrivalMicros;
+		currentRemoteAddress = packet->remoteAddress;
+		currentRemotePort = packet->remotePort;
+		dispatchPacket(packet->data, packet->size);
+		queue.pop();
+	}
+	currentArrivalMicros = 0;
+	currentRemoteAddress = 0;
+	currentRemotePort = 0;
+
+	if (replaying) updateReplay(now);
+
+	errorLog.update(ofGetElapsedTimef());
+}
+
+void OSCController::commitStagedParameters() {
+	ledStage.commit(*hourglassManager);
 }
 
 void OSCController::shutdown() {
 	if (oscEnabled) {
 		oscEnabled = false;
 	}
+	receiveThread.stop();
+	bundleScheduler.clear();
+	stopCapture();
+	stopReplay();
+}
+
+// Capture / replay -------------------------------------------------------------
+
+bool OSCController::startCapture(const std::string & path) {
+	std::string fullPath = ofToDataPath(path, true);
+	if (!captureLog.open(fullPath)) {
+		ofLogError("OSCController") << "Cannot open capture file " << fullPath;
+		return false;
+	}
+	ofLogNotice("OSCController") << "Capturing OSC input to " << fullPath;
+	return true;
+}
+
+void OSCController::stopCapture() {
+	if (!captureLog.isOpen()) return;
+	ofLogNotice("OSCController") << "Captured " << captureLog.getWrittenCount() << " packets to " << captureLog.getPath();
+	captureLog.close();
+}
+
+bool OSCController::startReplay(const std::string & path, bool realtime) {
+	if (replaying) {
+		ofLogError("OSCController") << "A replay is already running; stop it first";
+		return false;
+	}
+	std::string fullPath = ofToDataPath(path, true);
+	std::string error;
+	if (!OSCCaptureLog::load(fullPath, replayBytes, replayRecords, error)) {
+		ofLogError("OSCController") << "Cannot replay " << fullPath << ": " << error;
+		return false;
+	}
+	replayIndex = 0;
+	replayRealtime = realtime;
+	replayStartMicros = OSCReceiveThread::nowMicros();
+	replaying = true;
+	ofLogNotice("OSCController") << "Replaying " << replayRecords.size() << " packets from " << fullPath
+								 << (realtime ? " (real time)" : " (as fast as possible)");
+	return true;
+}
+
+void OSCController::stopReplay() {
+	replaying = false;
+	replayBytes.clear();
+	replayRecords.clear();
+	replayIndex = 0;
+}
+
+// Real time: release records whose recorded offset has elapsed.
+// Fast: dispatch the whole log in this tick and report throughput.
+void OSCController::updateReplay(uint64_t now) {
+	if (replayRecords.empty()) {
+		stopReplay();
+		return;
+	}
+
+	uint64_t firstArrival = replayRecords.front().arrivalMicros;
+	uint64_t elapsed = now - replayStartMicros;
+	size_t startIndex = replayIndex;
+
+	while (replayIndex < replayRecords.size()) {
+		const OSCCaptureLog::Record & record = replayRecords[replayIndex];
+		if (replayRealtime && record.arrivalMicros - firstArrival > elapsed) break;
+		currentArrivalMicros = OSCReceiveThread::nowMicros();
+		dispatchPacket(replayBytes.data() + record.offset, record.size);
+		if (!replaying) break; // the log itself contained /system/replay/stop
+		replayIndex++;
+	}
+	currentArrivalMicros = 0;
+
+	if (replaying && replayIndex >= replayRecords.size()) {
+		if (!replayRealtime) {
+			double seconds = (OSCReceiveThread::nowMicros() - now) / 1e6;
+			size_t count = replayIndex - startIndex;
+			ofLogNotice("OSCController") << "Replayed " << count << " packets in " << ofToString(seconds * 1000.0, 2) << " ms ("
+										 << ofToString(seconds > 0 ? count / seconds : 0.0, 0) << " packets/s)";
+		} else {
+			ofLogNotice("OSCController") << "Replay finished (" << replayIndex << " packets)";
+		}
+		stopReplay();
+	}
+}
+
+// /system/capture/start "file" | /system/capture/stop
+// /system/replay/start "file" [realtime 1|0] | /system/replay/stop
+void OSCController::handleSystemCaptureMessage(const OSCMessageView & msg, const OSCAddress & addressParts) {
+	std::string_view kind = addressParts[1];
+	std::string_view action = addressParts[2];
+
+	if (action == "stop") {
+		if (kind == "capture") {
+			stopCapture();
+		} else {
+			stopReplay();
+		}
+		return;
+	}
+
+	if (!OSCHelper::validateParameters(msg, 1, std::string(kind) + "_start")) return;
+	std::string_view name = OSCHelper::getArgument<std::string_view>(msg, 0, "");
+	std::string path;
+	if (!resolveCaptureFile(name, path)) {
+		sendError(msg.getAddress(), "Invalid capture file name '" + std::string(name) + "': use a plain file name inside data/captures/");
+		return;
+	}
+	if (kind == "capture") {
+		ofDirectory::createDirectory(CAPTURE_DIRECTORY, true, true);
+		startCapture(path);
+	} else {
+		bool realtime = msg.getNumArgs() > 1 ? OSCHelper::getArgument<int>(msg, 1, 1) != 0 : true;
+		startReplay(path, realtime);
+	}
+}
+
+bool OSCController::resolveCaptureFile(std::string_view name, std::string & path) {
+	if (name.empty() || name.find_first_of("/\\:") != std::string_view::npos || name.find("..") != std::string_view::npos) {
+		return false;
+	}
+	path = std::string(CAPTURE_DIRECTORY) + "/" + std::string(name);
+	return true;
+}
+
+OSCController::IngestStats OSCController::getIngestStats() const {
+	IngestStats stats;
+	stats.received = receiveThread.getReceivedCount();
+	stats.dropped = receiveThread.getDroppedCount();
+	stats.oversized = receiveThread.getOversizedCount();
+	stats.malformed = malformedCount;
+	stats.handlerErrors = handlerErrorCount;
+	stats.lastQueueDelayMicros = lastQueueDelayMicros;
+	stats.maxQueueDelayMicros = maxQueueDelayMicros;
+	return stats;
+}
+
+// Decode one datagram (message or bundle, bundles recurse) and dispatch it
+void OSCController::dispatchPacket(const char * data, std::size_t size) {
+	// Only decoding counts as malformed; handler failures are caught in processMessage()
+	std::optional<osc::ReceivedBundle> bundle;
+	try {
+		osc::ReceivedPacket packet(data, static_cast<osc::osc_bundle_element_size_t>(size));
+		if (packet.IsBundle()) bundle.emplace(packet); // validates every element
+	} catch (const std::exception & e) {
+		malformedCount++;
+		OSCHelper::logError("dispatchPacket", std::string("Malformed OSC packet: ") + e.what());
+		return;
+	}
+
+	if (bundle) {
+		// Future timetags wait in the scheduler; the whole bundle is re-dispatched when due
+		uint64_t timetag = bundle->TimeTag();
+		if (timetag != OSCBundleScheduler::IMMEDIATE_TIMETAG) {
+			uint64_t now = OSCReceiveThread::nowMicros();
+			uint64_t due = OSCBundleScheduler::timetagToSteadyMicros(timetag, now);
+			if (due > now + tickPeriodMicros / 2) {
+				bundleScheduler.schedule(due, data, size);
+				return;
+			}
+			if (currentArrivalMicros > 0 && due + tickPeriodMicros / 2 < currentArrivalMicros) {
+				bundleScheduler.noteExpired();
+			}
+		}
+
+		for (auto element = bundle->ElementsBegin(); element != bundle->ElementsEnd(); ++element) {
+			dispatchPacket(element->Contents(), static_cast<std::size_t>(element->Size()));
+		}
+		return;
+	}
+
+	OSCMessageView message;
+	if (!message.parse(data, size)) {
+		malformedCount++;
+		OSCHelper::logError("dispatchPacket", "Malformed OSC message");
+		return;
+	}
+	processMessage(message);
 }
 
+// Messages built in code (sequencer) are encoded once so every source reaches
+// the handlers through the same packet view
 void OSCController::processMessage(ofxOscMessage & message) {
+	char buffer[OSCPacket::MAX_SIZE];
+	osc::OutboundPacketStream stream(buffer, sizeof(buffer));
+	try {
+		OSCHelper::encodeMessage(message, stream);
+	} catch (const osc::Exception & e) {
+		sendError(message.getAddress(), std::string("Cannot encode message: ") + e.what());
+		return;
+	}
+
+	OSCMessageView view;
+	if (!view.parse(stream.Data(), stream.Size())) {
+		sendError(message.getAddress(), "Cannot decode encoded message");
+		return;
+	}
+	processMessage(view);
+}
+
+void OSCController::processMessage(const OSCMessageView & message) {
 	if (uiWrapper) {
 		uiWrapper->notifyOSCMessageReceived();
 	}
 
-	string address = message.getAddress();
-	vector<string> addressParts = ofSplitString(address, "/", true);
-
+	std::string_view address = message.getAddress();
+	OSCAddress addressParts;
+	if (!addressParts.parse(address)) {
+		sendError(address, "OSC address has too many segments");
+		return;
+	}
 	if (addressParts.empty()) {
 		sendError(address, "Invalid OSC address");
 		return;
 	}
 
-	// Handle blackout command
-	if (address == "/blackout") {
-		handleGlobalBlackoutMessage(message);
-		return;
+	if (const RouteHandler * handler = routes.find(addressParts)) {
+		try {
+			(*handler)(*this, message, addressParts);
+		} catch (const std::exception & e) {
+			handlerErrorCount++;
+			sendError(address, std::string("Handler failed: ") + e.what());
+		}
+	} else {
+		reportUnroutedAddress(addressParts);
 	}
+}
 
-	// Route to appropriate handler based on address structure
-	if (addressParts[0] == "hourglass") {
-		if (addressParts.size() >= 2 && (addressParts[1] == "connect" || addressParts[1] == "disconnect" || addressParts[1] == "status")) {
-			// Connection commands are no-ops in OSC-only mode (serial removed)
-		} else if (addressParts.size() >= 3) {
-			// Route to handlers based on command type - let each handler validate IDs
-			if (addressParts[2] == "motor") {
-				handleMotorMessage(message, addressParts);
-			} else if (addressParts[2] == "led" || addressParts[2] == "pwm" || addressParts[2] == "dotstar" || addressParts[2] == "main" || addressParts[2] == "up" || addressParts[2] == "down") {
-				handleLedMessage(message, addressParts);
-			} else if (addressParts[2] == "connect" || addressParts[2] == "disconnect" || addressParts[2] == "status") {
-				// Connection commands are no-ops in OSC-only mode (serial removed)
-			} else if (addressParts[2] == "blackout") {
-				// /hourglass/{id}/blackout == individual luminosity 0
-				applyIndividualLuminosity(addressParts, address, 0.0f);
-			} else if (addressParts[2] == "luminosity") {
-				handleIndividualLuminosityMessage(message, addressParts);
-			} else {
-				sendError(address, "Unknown hourglass command or motor subcommand: " + addressParts[2] + (addressParts.size() >= 4 ? "/" + addressParts[3] : ""));
-			}
+void OSCController::buildRoutes() {
+	auto noop = [](OSCController &, const OSCMessageView &, const OSCAddress &) {};
+
+	routes.add("/blackout", [](OSCController & c, const OSCMessageView & m, const OSCAddress &) { c.handleGlobalBlackoutMessage(m); });
+
+	// Connection commands are no-ops in OSC-only mode (serial removed)
+	for (const char * command : { "connect", "disconnect", "status" }) {
+		routes.add(std::string("/hourglass/") + command + "/**", noop);
+		routes.add(std::string("/hourglass/*/") + command + "/**", noop);
+	}
+
+	// Per-hourglass commands - each handler validates its own ids
+	routes.add("/hourglass/*/motor/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleMotorMessage(m, a); });
+	for (const char * target : { "led", "pwm", "dotstar", "main", "up", "down" }) {
+		routes.add(std::string("/hourglass/*/") + target + "/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleLedMessage(m, a); });
+	}
+	// /hourglass/{id}/blackout == individual luminosity 0
+	routes.add("/hourglass/*/blackout/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.applyIndividualLuminosity(a, m.getAddress(), 0.0f); });
+	routes.add("/hourglass/*/luminosity/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleIndividualLuminosityMessage(m, a); });
+	routes.add("/hourglass/*/effect/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleEffectMessage(m, a); });
+
+	// System commands
+	routes.add("/system/luminosity/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress &) { c.handleGlobalLuminosityMessage(m); });
+	for (const char * pattern : { "/system/capture/start", "/system/capture/stop", "/system/replay/start", "/system/replay/stop" }) {
+		routes.add(pattern, [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleSystemCaptureMessage(m, a); });
+	}
+	routes.add("/system/errors", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleSystemErrorsMessage(m, a); });
+	routes.add("/system/errors/clear", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleSystemErrorsMessage(m, a); });
+	routes.add("/system/stats", [](OSCController & c, const OSCMessageView & m, const OSCAddress &) { c.handleSystemStatsMessage(m); });
+	routes.add("/system/frame", [](OSCController & c, const OSCMessageView & m, const OSCAddress &) { c.handleSystemFrameMessage(m); });
+	routes.add("/system/list_devices/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleSystemMessage(m, a); });
+	routes.add("/system/emergency_stop_all/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleSystemMessage(m, a); });
+	routes.add("/system/motor/preset/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress &) { c.handleSystemMotorPresetMessage(m); });
+	routes.add("/system/motor/config/*/*/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleSystemMotorConfigMessage(m, a); });
+	routes.add("/system/motor/rotate/*/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleSystemMotorRotateMessage(m, a); });
+	routes.add("/system/motor/position/*/**", [](OSCController & c, const OSCMessageView & m, const OSCAddress & a) { c.handleSystemMotorPositionMessage(m, a); });
+	routes.add("/system/motor/set_zero_all/**", [](OSCController & c, const OSCMessageView &, const OSCAddress &) { c.hourglassManager->setZeroAll(); });
+}
+
+// Error path only: explain why an address matched no route
+void OSCController::reportUnroutedAddress(const OSCAddress & addressParts) {
+	std::string address(addressParts.str());
+	std::string namespaceName(addressParts[0]);
+
+	if (namespaceName == "hourglass") {
+		if (addressParts.size() >= 3) {
+			sendError(address, "Unknown hourglass command or motor subcommand: " + std::string(addressParts[2]) + (addressParts.size() >= 4 ? "/" + std::string(addressParts[3]) : ""));
 		} else {
 			sendError(address, "Incomplete hourglass address");
 		}
-	} else if (addressParts[0] == "system") {
+	} else if (namespaceName == "system") {
 		if (addressParts.size() >= 2) {
-			if (addressParts[1] == "luminosity") {
-				handleGlobalLuminosityMessage(message);
-			} else if (addressParts[1] == "list_devices" || addressParts[1] == "emergency_stop_all") {
-				handleSystemMessage(message, addressParts);
-			} else if (addressParts.size() >= 3 && addressParts[1] == "motor" && addressParts[2] == "preset") {
-				handleSystemMotorPresetMessage(message);
-			} else if (addressParts.size() >= 5 && addressParts[1] == "motor" && addressParts[2] == "config") {
-				handleSystemMotorConfigMessage(message, addressParts);
-			} else if (addressParts.size() >= 4 && addressParts[1] == "motor" && addressParts[2] == "rotate") {
-				handleSystemMotorRotateMessage(message, addressParts);
-			} else if (addressParts.size() >= 4 && addressParts[1] == "motor" && addressParts[2] == "position") {
-				handleSystemMotorPositionMessage(message, addressParts);
-			} else if (addressParts.size() >= 3 && addressParts[1] == "motor" && addressParts[2] == "set_zero_all") {
-				hourglassManager->setZeroAll();
-			} else {
-				sendError(address, "Unknown system command: " + addressParts[1] + (addressParts.size() >= 3 ? "/" + addressParts[2] : ""));
-			}
+			sendError(address, "Unknown system command: " + std::string(addressParts[1]) + (addressParts.size() >= 3 ? "/" + std::string(addressParts[2]) : ""));
 		} else {
 			sendError(address, "Incomplete system command.");
 		}
 	} else {
-		sendError(address, "Unknown OSC namespace: " + addressParts[0]);
+		sendError(address, "Unknown OSC namespace: " + namespaceName);
 	}
 }
 
 // Shared helpers ------------------------------------------------------------
 
-bool OSCController::lookupPreset(const std::string & presetName, const std::string & address, int & speed, int & accel) {
+bool OSCController::lookupPreset(std::string_view presetName, std::string_view address, int & speed, int & accel) {
 	auto it = motorPresets.find(presetName);
 	if (it == motorPresets.end()) {
-		sendError(address, "Unknown motor preset: '" + presetName + "'. Loaded presets: " + ofToString(motorPresets.size()));
+		sendError(address, "Unknown motor preset: '" + std::string(presetName) + "'. Loaded presets: " + ofToString(motorPresets.size()));
 		return false;
 	}
 	speed = it->second.first;
 	accel = it->second.second;
 	if (!OSCHelper::isValidMotorSpeed(speed) || !OSCHelper::isValidMotorAcceleration(accel)) {
-		sendError(address, "Preset '" + presetName + "' contains invalid speed/acceleration values.");
+		sendError(address, "Preset '" + std::string(presetName) + "' contains invalid speed/acceleration values.");
 		return false;
 	}
 	return true;
@@ -134,18 +394,29 @@ void OSCController::applyMotorSpeedAccel(HourGlass & hg, int speed, int accel) {
 
 // Parse degrees/speed/accel either from the address path (starting at angleIdx)
 // or, when the path carries no angle, from the message arguments.
-bool OSCController::parseAngleSpeedAccel(ofxOscMessage & msg, const std::vector<std::string> & addressParts, size_t angleIdx,
+bool OSCController::parseAngleSpeedAccel(const OSCMessageView & msg, const OSCAddress & addressParts, size_t angleIdx,
 	const std::string & context, float & degrees, std::optional<int> & speed, std::optional<int> & accel) {
 	if (addressParts.size() > angleIdx) {
-		try {
-			degrees = std::stof(addressParts[angleIdx]);
-			if (addressParts.size() > angleIdx + 1) speed = std::stoi(addressParts[angleIdx + 1]);
-			if (addressParts.size() > angleIdx + 2) accel = std::stoi(addressParts[angleIdx + 2]);
-			return true;
-		} catch (const std::exception &) {
+		int value = 0;
+		if (!addressParts.toFloat(angleIdx, degrees)) {
 			sendError(msg.getAddress(), "Invalid path format for " + context);
 			return false;
 		}
+		if (addressParts.size() > angleIdx + 1) {
+			if (!addressParts.toInt(angleIdx + 1, value)) {
+				sendError(msg.getAddress(), "Invalid path format for " + context);
+				return false;
+			}
+			speed = value;
+		}
+		if (addressParts.size() > angleIdx + 2) {
+			if (!addressParts.toInt(angleIdx + 2, value)) {
+				sendError(msg.getAddress(), "Invalid path format for " + context);
+				return false;
+			}
+			accel = value;
+		}
+		return true;
 	}
 
 	if (!OSCHelper::validateParameters(msg, 1, context)) return false;
@@ -155,24 +426,24 @@ bool OSCController::parseAngleSpeedAccel(ofxOscMessage & msg, const std::vector<
 	return true;
 }
 
-// Validate a single int argument against [minValue, maxValue] and assign it to
-// the given up/down LED parameters (either may be null).
-void OSCController::setLedRangeParam(ofxOscMessage & msg, const std::string & context, int minValue, int maxValue, int defaultValue,
-	ofParameter<int> * upParam, ofParameter<int> * downParam) {
+// Validate a single int argument against [minValue, maxValue] and stage it
+// for the requested up/down sides of one hourglass.
+void OSCController::setLedRangeParam(const OSCMessageView & msg, const std::string & context, int minValue, int maxValue, int defaultValue,
+	int hourglassId, LedParameterStage::Field field, bool up, bool down) {
 	if (!OSCHelper::validateParameters(msg, 1, "led_" + context)) return;
 	int value = OSCHelper::getArgument<int>(msg, 0, defaultValue);
 	if (value < minValue || value > maxValue) {
 		sendError(msg.getAddress(), "Invalid " + context + " value (" + ofToString(minValue) + "-" + ofToString(maxValue) + ")");
 		return;
 	}
-	if (upParam) upParam->set(value);
-	if (downParam) downParam->set(value);
+	if (up) ledStage.stage(hourglassId - 1, LedParameterStage::UP, field, value);
+	if (down) ledStage.stage(hourglassId - 1, LedParameterStage::DOWN, field, value);
 }
 
 // Motor ---------------------------------------------------------------------
 
-void OSCController::handleMotorMessage(ofxOscMessage & msg, const vector<string> & addressParts) {
-	string address = msg.getAddress();
+void OSCController::handleMotorMessage(const OSCMessageView & msg, const OSCAddress & addressParts) {
+	std::string_view address = msg.getAddress();
 	if (addressParts.size() < 4) {
 		sendError(address, "Incomplete motor command");
 		return;
@@ -186,15 +457,15 @@ void OSCController::handleMotorMessage(ofxOscMessage & msg, const vector<string>
 
 	int hourglassId = extractHourglassId(addressParts);
 	if (!isValidHourglassId(hourglassId)) {
-		sendError(address, "Invalid hourglass ID: " + addressParts[1]);
+		sendError(address, "Invalid hourglass ID: " + std::string(addressParts[1]));
 		return;
 	}
 	HourGlass * hg = getHourglassById(hourglassId);
 	if (!hg) {
-		sendError(address, "Hourglass not found: " + addressParts[1]);
+		sendError(address, "Hourglass not found: " + std::string(addressParts[1]));
 		return;
 	}
-	string command = addressParts[3];
+	std::string_view command = addressParts[3];
 
 	if (command == "enable") {
 		if (!OSCHelper::validateParameters(msg, 1, "motor_enable")) return;
@@ -258,7 +529,7 @@ void OSCController::handleMotorMessage(ofxOscMessage & msg, const vector<string>
 		float degrees_val = 0.0f;
 		std::optional<int> speed_opt = std::nullopt;
 		std::optional<int> accel_opt = std::nullopt;
-		if (!parseAngleSpeedAccel(msg, addressParts, 4, "motor_" + command, degrees_val, speed_opt, accel_opt)) return;
+		if (!parseAngleSpeedAccel(msg, addressParts, 4, command == "rotate" ? "motor_rotate" : "motor_position", degrees_val, speed_opt, accel_opt)) return;
 
 		if (command == "rotate") {
 			hg->commandRelativeAngle(degrees_val, speed_opt, accel_opt);
@@ -271,7 +542,7 @@ void OSCController::handleMotorMessage(ofxOscMessage & msg, const vector<string>
 	} else if (command == "preset") {
 		// /hourglass/{id}/motor/preset "name"
 		if (!OSCHelper::validateParameters(msg, 1, "motor_preset")) return;
-		std::string presetName = OSCHelper::getArgument<std::string>(msg, 0, "smooth");
+		std::string_view presetName = OSCHelper::getArgument<std::string_view>(msg, 0, "smooth");
 		int speed, accel;
 		if (lookupPreset(presetName, address, speed, accel)) {
 			applyMotorSpeedAccel(*hg, speed, accel);
@@ -283,69 +554,62 @@ void OSCController::handleMotorMessage(ofxOscMessage & msg, const vector<string>
 			sendError(address, "Incomplete motor config command. Expected /hourglass/{id}/motor/config/{speed}/{accel}");
 			return;
 		}
-		try {
-			int speed_val = std::stoi(addressParts[4]);
-			int accel_val = std::stoi(addressParts[5]);
+		int speed_val = 0, accel_val = 0;
+		if (!addressParts.toInt(4, speed_val) || !addressParts.toInt(5, accel_val)) {
+			sendError(address, "Invalid number format for motor config speed/accel");
+			return;
+		}
 
-			if (!OSCHelper::isValidMotorSpeed(speed_val) || !OSCHelper::isValidMotorAcceleration(accel_val)) {
-				OSCHelper::logError("motor_config", address, "Invalid speed/acceleration for HG " + ofToString(hourglassId) + ". Speed(0-500): " + ofToString(speed_val) + ", Accel(0-255): " + ofToString(accel_val));
-				return;
-			}
-			applyMotorSpeedAccel(*hg, speed_val, accel_val);
-		} catch (const std::exception & e) {
-			sendError(address, "Invalid number format for motor config speed/accel: " + std::string(e.what()));
+		if (!OSCHelper::isValidMotorSpeed(speed_val) || !OSCHelper::isValidMotorAcceleration(accel_val)) {
+			OSCHelper::logError("motor_config", address, "Invalid speed/acceleration for HG " + ofToString(hourglassId) + ". Speed(0-500): " + ofToString(speed_val) + ", Accel(0-255): " + ofToString(accel_val));
+			return;
 		}
+		applyMotorSpeedAccel(*hg, speed_val, accel_val);
 
 	} else {
-		sendError(address, "Unknown motor command: " + command);
+		sendError(address, "Unknown motor command: " + std::string(command));
 	}
 }
 
 // LED -----------------------------------------------------------------------
 
-void OSCController::handleLedMessage(ofxOscMessage & msg, const vector<string> & addressParts) {
-	string address = msg.getAddress();
+void OSCController::handleLedMessage(const OSCMessageView & msg, const OSCAddress & addressParts) {
+	std::string_view address = msg.getAddress();
 	if (addressParts.size() < 4) {
 		sendError(address, "Incomplete LED command");
 		return;
 	}
 
-	std::vector<int> hourglassIds = extractHourglassIds(addressParts);
-	if (hourglassIds.empty()) {
-		sendError(address, "Invalid hourglass target: " + addressParts[1] + " (use: 1, 1-3, or all)");
-		return;
-	}
-
-	string target = addressParts[2];
-	string command = addressParts[3];
+	std::string_view target = addressParts[2];
+	std::string_view command = addressParts[3];
 
-	// Apply to all targeted hourglasses
+	// Stage for all targeted hourglasses (applied once per tick by commitStagedParameters)
 	bool firstHourglass = true;
-	for (int hourglassId : hourglassIds) {
-		HourGlass * hg = getHourglassById(hourglassId);
-		if (!hg) continue;
-
+	int targeted = resolveTargets(addressParts).forEach(hourglassManager->getHourGlassCount(), [&](int hourglassId) {
 		if (target == "pwm") {
-			handlePWMMessageForHourglass(msg, hg, addressParts);
+			handlePWMMessageForHourglass(msg, hourglassId, addressParts);
 		} else if (target == "main") {
-			handleMainLedMessageForHourglass(msg, hg, addressParts);
+			handleMainLedMessageForHourglass(msg, hourglassId, addressParts);
 		} else if (target == "up" || target == "down") {
-			handleIndividualLedMessageForHourglass(msg, hg, target, command);
+			handleIndividualLedMessageForHourglass(msg, hourglassId, target, command);
 		} else if (target == "led") {
-			handleAllLedMessageForHourglass(msg, hg, command, addressParts);
+			handleAllLedMessageForHourglass(msg, hourglassId, command, addressParts);
 		} else if (firstHourglass) {
 			// Only send error once, not per hourglass
-			sendError(address, "Unknown LED target: " + target);
+			sendError(address, "Unknown LED target: " + std::string(target));
 		}
 		firstHourglass = false;
+	});
+
+	if (targeted == 0) {
+		sendError(address, "Invalid hourglass target: " + std::string(addressParts[1]) + " (use: 1, 1-3, 1,4-8,12 or all)");
 	}
 }
 
-void OSCController::handleIndividualLedMessageForHourglass(ofxOscMessage & msg, HourGlass * hg, const string & target, const string & command) {
-	string address = msg.getAddress();
+void OSCController::handleIndividualLedMessageForHourglass(const OSCMessageView & msg, int hourglassId, std::string_view target, std::string_view command) {
+	std::string_view address = msg.getAddress();
 	bool isUp = (target == "up");
-
-	hg->updatingFromOSC = true;
+	LedParameterStage::Side side = isUp ? LedParameterStage::UP : LedParameterStage::DOWN;
 
 	if (command == "rgb") {
 		if (OSCHelper::validateParameters(msg, 3, "led_rgb")) {
@@ -353,7 +617,7 @@ void OSCController::handleIndividualLedMessageForHourglass(ofxOscMessage & msg,
 			if (!OSCHelper::isValidColorValue(r) || !OSCHelper::isValidColorValue(g) || !OSCHelper::isValidColorValue(b)) {
 				sendError(address, "Invalid RGB values (0-255)");
 			} else {
-				(isUp ? hg->upLedColor : hg->downLedColor).set(ofColor(r, g, b));
+				ledStage.stageColor(hourglassId - 1, side, ofColor(r, g, b));
 			}
 		}
 	} else if (command == "brightness") {
@@ -362,29 +626,25 @@ void OSCController::handleIndividualLedMessageForHourglass(ofxOscMessage & msg,
 			if (!OSCHelper::isValidColorValue(brightness)) {
 				sendError(address, "Invalid brightness value (0-255)");
 			} else {
-				(isUp ? hg->upLedColor : hg->downLedColor).set(ofColor(brightness, brightness, brightness));
+				ledStage.stageColor(hourglassId - 1, side, ofColor(brightness, brightness, brightness));
 			}
 		}
 	} else if (command == "blend") {
-		setLedRangeParam(msg, "blend", 0, 768, 0, isUp ? &hg->upLedBlend : &hg->downLedBlend, nullptr);
+		setLedRangeParam(msg, "blend", 0, 768, 0, hourglassId, LedParameterStage::BLEND, isUp, !isUp);
 	} else if (command == "origin") {
-		setLedRangeParam(msg, "origin", 0, 360, 0, isUp ? &hg->upLedOrigin : &hg->downLedOrigin, nullptr);
+		setLedRangeParam(msg, "origin", 0, 360, 0, hourglassId, LedParameterStage::ORIGIN, isUp, !isUp);
 	} else if (command == "arc") {
-		setLedRangeParam(msg, "arc", 0, 360, 360, isUp ? &hg->upLedArc : &hg->downLedArc, nullptr);
+		setLedRangeParam(msg, "arc", 0, 360, 360, hourglassId, LedParameterStage::ARC, isUp, !isUp);
 	} else {
-		sendError(address, "Unknown " + target + " LED command: " + command);
+		sendError(address, "Unknown " + std::string(target) + " LED command: " + std::string(command));
 	}
-
-	hg->updatingFromOSC = false;
 }
 
-void OSCController::handleAllLedMessageForHourglass(ofxOscMessage & msg, HourGlass * hg, const string & command, const vector<string> & addressParts) {
-	string address = msg.getAddress();
-
-	hg->updatingFromOSC = true;
+void OSCController::handleAllLedMessageForHourglass(const OSCMessageView & msg, int hourglassId, std::string_view command, const OSCAddress & addressParts) {
+	std::string_view address = msg.getAddress();
 
 	if (command == "all" && addressParts.size() >= 5) {
-		const string & subCommand = addressParts[4];
+		std::string_view subCommand = addressParts[4];
 		if (subCommand == "rgb") {
 			if (msg.getNumArgs() == 3) {
 				int r, g, b;
@@ -397,38 +657,39 @@ void OSCController::handleAllLedMessageForHourglass(ofxOscMessage & msg, HourGla
 					g = static_cast<uint8_t>(ofClamp(OSCHelper::getArgument<int>(msg, 1), 0, 255));
 					b = static_cast<uint8_t>(ofClamp(OSCHelper::getArgument<int>(msg, 2), 0, 255));
 				}
-				hg->setAllLEDs(r, g, b);
+				ledStage.stageColor(hourglassId - 1, LedParameterStage::UP, ofColor(r, g, b));
+				ledStage.stageColor(hourglassId - 1, LedParameterStage::DOWN, ofColor(r, g, b));
 			} else if (msg.getNumArgs() == 1 && msg.getArgType(0) == OFXOSC_TYPE_RGBA_COLOR) {
-				ofColor color = msg.getArgAsRgbaColor(0);
-				hg->setAllLEDs(color.r, color.g, color.b);
+				uint32_t rgba = msg.getRgbaColor(0);
+				ofColor color = ofColor::fromHex(rgba >> 8, rgba & 0xff);
+				ledStage.stageColor(hourglassId - 1, LedParameterStage::UP, color);
+				ledStage.stageColor(hourglassId - 1, LedParameterStage::DOWN, color);
 			} else {
 				sendError(address, "Invalid RGB format. Expected 3 numbers or RGBA color type");
 			}
 		} else if (subCommand == "blend") {
-			setLedRangeParam(msg, "blend", 0, 768, 0, &hg->upLedBlend, &hg->downLedBlend);
+			setLedRangeParam(msg, "blend", 0, 768, 0, hourglassId, LedParameterStage::BLEND, true, true);
 		} else if (subCommand == "origin") {
-			setLedRangeParam(msg, "origin", 0, 360, 0, &hg->upLedOrigin, &hg->downLedOrigin);
+			setLedRangeParam(msg, "origin", 0, 360, 0, hourglassId, LedParameterStage::ORIGIN, true, true);
 		} else if (subCommand == "arc") {
-			setLedRangeParam(msg, "arc", 0, 360, 360, &hg->upLedArc, &hg->downLedArc);
+			setLedRangeParam(msg, "arc", 0, 360, 360, hourglassId, LedParameterStage::ARC, true, true);
 		} else {
-			sendError(address, "Unknown 'all' LED command: " + subCommand);
+			sendError(address, "Unknown 'all' LED command: " + std::string(subCommand));
 		}
 	} else if (command == "all") {
 		sendError(address, "Unknown 'all' LED command:  (expected rgb/blend/origin/arc)");
 	} else {
-		sendError(address, "Unknown LED command: " + command);
+		sendError(address, "Unknown LED command: " + std::string(command));
 	}
-
-	hg->updatingFromOSC = false;
 }
 
-void OSCController::handlePWMMessageForHourglass(ofxOscMessage & msg, HourGlass * hg, const vector<string> & addressParts) {
-	string address = msg.getAddress();
+void OSCController::handlePWMMessageForHourglass(const OSCMessageView & msg, int hourglassId, const OSCAddress & addressParts) {
+	std::string_view address = msg.getAddress();
 	if (addressParts.size() < 4) {
 		sendError(address, "Incomplete PWM command");
 		return;
 	}
-	string target = addressParts[3];
+	std::string_view target = addressParts[3];
 	if (target != "up" && target != "down" && target != "all") {
 		sendError(address, "Invalid PWM target");
 		return;
@@ -440,19 +701,17 @@ void OSCController::handlePWMMessageForHourglass(ofxOscMessage & msg, HourGlass
 		return;
 	}
 
-	hg->updatingFromOSC = true;
-	if (target == "up" || target == "all") hg->upPwm.set(pwmValue);
-	if (target == "down" || target == "all") hg->downPwm.set(pwmValue);
-	hg->updatingFromOSC = false;
+	if (target == "up" || target == "all") ledStage.stage(hourglassId - 1, LedParameterStage::UP, LedParameterStage::PWM, pwmValue);
+	if (target == "down" || target == "all") ledStage.stage(hourglassId - 1, LedParameterStage::DOWN, LedParameterStage::PWM, pwmValue);
 }
 
-void OSCController::handleMainLedMessageForHourglass(ofxOscMessage & msg, HourGlass * hg, const vector<string> & addressParts) {
-	string address = msg.getAddress();
+void OSCController::handleMainLedMessageForHourglass(const OSCMessageView & msg, int hourglassId, const OSCAddress & addressParts) {
+	std::string_view address = msg.getAddress();
 	if (addressParts.size() < 4) {
 		sendError(address, "Incomplete Main LED command");
 		return;
 	}
-	string target = addressParts[3];
+	std::string_view target = addressParts[3];
 	if (target != "up" && target != "down" && target != "all") {
 		sendError(address, "Invalid Main LED target");
 		return;
@@ -464,21 +723,19 @@ void OSCController::handleMainLedMessageForHourglass(ofxOscMessage & msg, HourGl
 		return;
 	}
 
-	hg->updatingFromOSC = true;
-	if (target == "up" || target == "all") hg->upMainLed.set(ledValue);
-	if (target == "down" || target == "all") hg->downMainLed.set(ledValue);
-	hg->updatingFromOSC = false;
+	if (target == "up" || target == "all") ledStage.stage(hourglassId - 1, LedParameterStage::UP, LedParameterStage::MAIN_LED, ledValue);
+	if (target == "down" || target == "all") ledStage.stage(hourglassId - 1, LedParameterStage::DOWN, LedParameterStage::MAIN_LED, ledValue);
 }
 
 // System --------------------------------------------------------------------
 
-void OSCController::handleSystemMessage(ofxOscMessage & msg, const vector<string> & addressParts) {
-	string address = msg.getAddress();
+void OSCController::handleSystemMessage(const OSCMessageView & msg, const OSCAddress & addressParts) {
+	std::string_view address = msg.getAddress();
 	if (addressParts.size() < 2) {
 		sendError(address, "Incomplete system command");
 		return;
 	}
-	string command = addressParts[1];
+	std::string_view command = addressParts[1];
 	if (command == "list_devices") {
 		auto devices = hourglassManager->getAvailableSerialPorts();
 
@@ -486,11 +743,11 @@ void OSCController::handleSystemMessage(ofxOscMessage & msg, const vector<string
 		hourglassManager->emergencyStopAll();
 
 	} else {
-		sendError(address, "Unknown system command: " + command);
+		sendError(address, "Unknown system command: " + std::string(command));
 	}
 }
 
-void OSCController::handleGlobalBlackoutMessage(ofxOscMessage & msg) {
+void OSCController::handleGlobalBlackoutMessage(const OSCMessageView & msg) {
 	LedMagnetController::setGlobalLuminosity(0.0f);
 	if (uiWrapper) {
 		uiWrapper->updateGlobalLuminositySlider(0.0f);
@@ -498,7 +755,7 @@ void OSCController::handleGlobalBlackoutMessage(ofxOscMessage & msg) {
 	hourglassManager->refreshAllLedStates();
 }
 
-void OSCController::handleGlobalLuminosityMessage(ofxOscMessage & msg) {
+void OSCController::handleGlobalLuminosityMessage(const OSCMessageView & msg) {
 	if (!OSCHelper::validateParameters(msg, 1, "system_luminosity")) return;
 
 	float luminosity = OSCHelper::getArgument<float>(msg, 0, 1.0f);
@@ -512,7 +769,7 @@ void OSCController::handleGlobalLuminosityMessage(ofxOscMessage & msg) {
 	hourglassManager->refreshAllLedStates();
 }
 
-void OSCController::applyIndividualLuminosity(const std::vector<std::string> & addressParts, const std::string & address, float value) {
+void OSCController::applyIndividualLuminosity(const OSCAddress & addressParts, std::string_view address, float value) {
 	if (addressParts.size() < 3) {
 		OSCHelper::logError("IndividualLuminosity", address, "Incomplete address for individual luminosity/blackout.");
 		return;
@@ -535,13 +792,13 @@ void OSCController::applyIndividualLuminosity(const std::vector<std::string> & a
 	// Handle individual hourglass
 	int hourglassId = extractHourglassId(addressParts);
 	if (!isValidHourglassId(hourglassId)) {
-		OSCHelper::logError("IndividualLuminosity", address, "Invalid hourglass ID: " + addressParts[1]);
+		OSCHelper::logError("IndividualLuminosity", address, "Invalid hourglass ID: " + std::string(addressParts[1]));
 		return;
 	}
 
 	HourGlass * hg = getHourglassById(hourglassId);
 	if (!hg) {
-		OSCHelper::logError("IndividualLuminosity", address, "Hourglass not found: " + addressParts[1]);
+		OSCHelper::logError("IndividualLuminosity", address, "Hourglass not found: " + std::string(addressParts[1]));
 		return;
 	}
 
@@ -555,7 +812,7 @@ void OSCController::applyIndividualLuminosity(const std::vector<std::string> & a
 	hg->refreshLedState();
 }
 
-void OSCController::handleIndividualLuminosityMessage(ofxOscMessage & msg, const vector<string> & addressParts) {
+void OSCController::handleIndividualLuminosityMessage(const OSCMessageView & msg, const OSCAddress & addressParts) {
 	if (!OSCHelper::validateParameters(msg, 1, "individual_luminosity")) return;
 	float luminosityValue = OSCHelper::getArgument<float>(msg, 0, 1.0f);
 	luminosityValue = ofClamp(luminosityValue, 0.0f, 1.0f);
@@ -563,10 +820,257 @@ void OSCController::handleIndividualLuminosityMessage(ofxOscMessage & msg, const
 	applyIndividualLuminosity(addressParts, msg.getAddress(), luminosityValue);
 }
 
-void OSCController::handleSystemMotorPresetMessage(ofxOscMessage & msg) {
-	string address = msg.getAddress();
+// Effects ---------------------------------------------------------------------
+
+// /hourglass/{targets}/effect/arc[/up|/down|/all] minArc maxArc period [phase] [phaseStep]
+//   adds an arc cosine sweep to each targeted hourglass. Effects run on the
+//   shared installation clock: phase (in periods) offsets all of them,
+//   phaseStep adds that much more per targeted hourglass, in id order, so
+//   the sweep travels across the installation.
+// /hourglass/{targets}/effect/clear[/up|/down|/all] removes their effects.
+void OSCController::handleEffectMessage(const OSCMessageView & msg, const OSCAddress & addressParts) {
+	std::string_view address = msg.getAddress();
+	if (addressParts.size() < 4) {
+		sendError(address, "Incomplete effect command");
+		return;
+	}
+
+	std::string_view command = addressParts[3];
+	std::string_view sides = addressParts.size() >= 5 ? addressParts[4] : "all";
+	bool top = sides == "all" || sides == "up";
+	bool bottom = sides == "all" || sides == "down";
+	if (!top && !bottom) {
+		sendError(address, "Unknown effect side: " + std::string(sides) + " (use: up, down or all)");
+		return;
+	}
+
+	std::vector<size_t> hourglassIndices;
+	resolveTargets(addressParts).forEach(hourglassManager->getHourGlassCount(), [&](int hourglassId) {
+		hourglassIndices.push_back(static_cast<size_t>(hourglassId - 1));
+	});
+	if (hourglassIndices.empty()) {
+		sendError(address, "Invalid hourglass target: " + std::string(addressParts[1]) + " (use: 1, 1-3, 1,4-8,12 or all)");
+		return;
+	}
+
+	EffectEngine & effects = hourglassManager->getEffectEngine();
+	if (command == "clear") {
+		for (size_t index : hourglassIndices) {
+			if (top) effects.clearSlot(HourGlassManager::ledSlot(index, true));
+			if (bottom) effects.clearSlot(HourGlassManager::ledSlot(index, false));
+		}
+	} else if (command == "arc") {
+		size_t args = msg.getNumArgs();
+		if (args < 3 || args > 5) {
+			sendError(address, "Expected minArc maxArc period [phase] [phaseStep], got " + ofToString(args) + " arguments");
+			return;
+		}
+		float minArc = OSCHelper::getArgument<float>(msg, 0, 0.0f);
+		float maxArc = OSCHelper::getArgument<float>(msg, 1, 360.0f);
+		float period = OSCHelper::getArgument<float>(msg, 2, 0.0f);
+		float phase = OSCHelper::getArgument<float>(msg, 3, 0.0f);
+		float phaseStep = OSCHelper::getArgument<float>(msg, 4, 0.0f);
+		if (minArc < 0.0f || minArc > 360.0f || maxArc < 0.0f || maxArc > 360.0f) {
+			sendError(address, "Invalid arc range (0-360)");
+		} else if (period <= 0.0f) {
+			sendError(address, "Invalid period (seconds, > 0)");
+		} else {
+			hourglassManager->setEffectWave(hourglassIndices, top, bottom, ArcCosineEffect(minArc, maxArc, period, phase), phaseStep);
+		}
+	} else {
+		sendError(address, "Unknown effect: " + std::string(command) + " (use: arc or clear)");
+	}
+}
+
+// /system/errors [replyPort]: send the error ring back to the querying host as
+// /system/errors/entry address kind count secondsAgo lastMessage (oldest first)
+// followed by /system/errors/end entries reported suppressed.
+// Without a network sender (sequencer, replay) the ring is written to the log.
+// /system/errors/clear empties the ring.
+void OSCController::handleSystemErrorsMessage(const OSCMessageView & msg, const OSCAddress & addressParts) {
+	if (addressParts.size() >= 3 && addressParts[2] == "clear") {
+		errorLog.clear();
+		return;
+	}
+
+	double now = ofGetElapsedTimef();
+	OSCErrorLog::Stats stats = errorLog.getStats();
+	uint64_t suppressed = stats.reported - stats.logged;
+
+	if (!setupReplySender(msg)) {
+		ofLogNotice("OSCController") << errorLog.getSize() << " error keys, " << stats.reported << " reports, " << suppressed << " not logged individually";
+		errorLog.forEach([&](const OSCErrorLog::Entry & entry) {
+			ofLogNotice("OSCController") << "  [" << entry.address << "] " << entry.kind << " x" << entry.count
+										 << " (" << ofToString(now - entry.lastSeen, 1) << " s ago): " << entry.message;
+		});
+		return;
+	}
+
+	errorLog.forEach([&](const OSCErrorLog::Entry & entry) {
+		ofxOscMessage reply;
+		reply.setAddress("/system/errors/entry");
+		reply.addStringArg(entry.address);
+		reply.addStringArg(entry.kind);
+		reply.addInt64Arg(static_cast<int64_t>(entry.count));
+		reply.addFloatArg(static_cast<float>(now - entry.lastSeen));
+		reply.addStringArg(entry.message);
+		replySender.sendMessage(reply, false);
+	});
+	ofxOscMessage end;
+	end.setAddress("/system/errors/end");
+	end.addIntArg(static_cast<int32_t>(errorLog.getSize()));
+	end.addInt64Arg(static_cast<int64_t>(stats.reported));
+	end.addInt64Arg(static_cast<int64_t>(suppressed));
+	replySender.sendMessage(end, false);
+}
+
+// False when the message did not come from the network (nothing to reply to)
+bool OSCController::setupReplySender(const OSCMessageView & msg) {
+	if (currentRemoteAddress == 0) return false;
+	std::string host = ofToString((currentRemoteAddress >> 24) & 0xFF) + "." + ofToString((currentRemoteAddress >> 16) & 0xFF) + "."
+		+ ofToString((currentRemoteAddress >> 8) & 0xFF) + "." + ofToString(currentRemoteAddress & 0xFF);
+	int port = msg.getNumArgs() > 0 ? OSCHelper::getArgument<int>(msg, 0, currentRemotePort) : currentRemotePort;
+	if (host != replyHost || port != replyPort) {
+		replySender.setup(host, port);
+		replyHost = host;
+		replyPort = port;
+	}
+	return true;
+}
+
+// /system/stats [replyPort]: one /system/stats/endpoint per egress ip:port,
+// then /system/stats/egress totals and /system/stats/end
+void OSCController::handleSystemStatsMessage(const OSCMessageView & msg) {
+	OSCEgressService & egress = OSCEgressService::instance();
+	auto endpoints = egress.getEndpoints();
+	OSCEgressService::Stats totals = egress.getStats();
+	OSCEgressService::AckStats acks = egress.getAckStats();
+	const OSCBundleScheduler::Stats & bundles = bundleScheduler.getStats();
+
+	if (!setupReplySender(msg)) {
+		ofLogNotice("OSCController") << "Bundles: " << bundleScheduler.size() << " pending, " << bundles.scheduled << " scheduled, "
+									 << bundles.applied << " applied, " << bundles.expired << " expired, " << bundles.dropped
+									 << " dropped, lateness last/max/mean abs " << bundles.lastLatenessMicros << "/"
+									 << bundles.maxLatenessMicros << "/" << ofToString(bundles.meanAbsLatenessMicros, 1) << " us";
+		ofLogNotice("OSCController") << endpoints.size() << " egress endpoints, " << totals.datagrams << " datagrams in " << totals.syscalls << " syscalls";
+		for (const auto & endpoint : endpoints) {
+			OSCEgressService::Endpoint::Stats stats = endpoint->getStats();
+			ofLogNotice("OSCController") << "  " << endpoint->getHost() << ":" << endpoint->getPort() << " " << stats.packets << " pkts, "
+										 << stats.bytes << " B, " << ofToString(stats.packetsPerSecond, 1) << " pkt/s, "
+										 << ofToString(stats.bytesPerSecond / 1024.0f, 1) << " KB/s, " << stats.errors << " errors, "
+										 << stats.queuedRepeats << " queued, " << stats.coalesced << " coalesced, " << stats.dropped
+										 << " dropped, send p50/p99/max " << stats.sendLatencyP50Micros << "/" << stats.sendLatencyP99Micros
+										 << "/" << stats.sendLatencyMaxMicros << " us";
+		}
+		return;
+	}
+
+	for (const auto & endpoint : endpoints) {
+		OSCEgressService::Endpoint::Stats stats = endpoint->getStats();
+		ofxOscMessage reply;
+		reply.setAddress("/system/stats/endpoint");
+		reply.addStringArg(endpoint->getHost());
+		reply.addIntArg(endpoint->getPort());
+		reply.addInt64Arg(static_cast<int64_t>(stats.packets));
+		reply.addInt64Arg(static_cast<int64_t>(stats.bytes));
+		reply.addInt64Arg(static_cast<int64_t>(stats.errors));
+		reply.addInt64Arg(stats.queuedRepeats);
+		reply.addInt64Arg(static_cast<int64_t>(stats.coalesced));
+		reply.addInt64Arg(static_cast<int64_t>(stats.dropped));
+		reply.addFloatArg(stats.packetsPerSecond);
+		reply.addFloatArg(stats.bytesPerSecond);
+		reply.addIntArg(static_cast<int32_t>(stats.sendLatencyP50Micros));
+		reply.addIntArg(static_cast<int32_t>(stats.sendLatencyP99Micros));
+		reply.addIntArg(static_cast<int32_t>(stats.sendLatencyMaxMicros));
+		replySender.sendMessage(reply, false);
+	}
+	ofxOscMessage summary;
+	summary.setAddress("/system/stats/egress");
+	summary.addInt64Arg(static_cast<int64_t>(totals.datagrams));
+	summary.addInt64Arg(static_cast<int64_t>(totals.syscalls));
+	summary.addIntArg(static_cast<int32_t>(totals.lastTickDatagrams));
+	summary.addIntArg(static_cast<int32_t>(totals.lastTickSyscalls));
+	summary.addIntArg(static_cast<int32_t>(acks.inFlight));
+	summary.addInt64Arg(static_cast<int64_t>(acks.retransmits));
+	summary.addInt64Arg(static_cast<int64_t>(acks.expired));
+	summary.addFloatArg(acks.smoothedRttMs);
+	replySender.sendMessage(summary, false);
+	ofxOscMessage scheduled;
+	scheduled.setAddress("/system/stats/bundles");
+	scheduled.addIntArg(static_cast<int32_t>(bundleScheduler.size()));
+	scheduled.addInt64Arg(static_cast<int64_t>(bundles.scheduled));
+	scheduled.addInt64Arg(static_cast<int64_t>(bundles.applied));
+	scheduled.addInt64Arg(static_cast<int64_t>(bundles.expired));
+	scheduled.addInt64Arg(static_cast<int64_t>(bundles.dropped));
+	scheduled.addInt64Arg(bundles.lastLatenessMicros);
+	scheduled.addInt64Arg(bundles.maxLatenessMicros);
+	scheduled.addFloatArg(static_cast<float>(bundles.meanAbsLatenessMicros));
+	replySender.sendMessage(scheduled, false);
+	ofxOscMessage end;
+	end.setAddress("/system/stats/end");
+	end.addIntArg(static_cast<int32_t>(endpoints.size()));
+	replySender.sendMessage(end, false);
+}
+
+// /system/frame <blob>: full LED state for a run of hourglasses, see LedFrameBlob.h
+void OSCController::handleSystemFrameMessage(const OSCMessageView & msg) {
+	std::string_view address = msg.getAddress();
+	if (msg.getNumArgs() < 1 || msg.getArgType(0) != OFXOSC_TYPE_BLOB) {
+		sendError(address, "Expected a frame blob argument");
+		return;
+	}
+
+	std::string_view blob = msg.getBlob(0);
+	const uint8_t * data = reinterpret_cast<const uint8_t *>(blob.data());
+	if (blob.size() < LedFrameBlob::HEADER_SIZE) {
+		sendError(address, "Frame blob too short for header");
+		return;
+	}
+	LedFrameBlob::Header header = LedFrameBlob::readHeader(data);
+	if (header.version != LedFrameBlob::VERSION) {
+		sendError(address, "Unsupported frame version: " + ofToString(int(header.version)));
+		return;
+	}
+	if (blob.size() < LedFrameBlob::expectedSize(header)) {
+		sendError(address, "Frame blob truncated: " + ofToString(blob.size()) + " bytes for " + ofToString(header.count) + " hourglasses");
+		return;
+	}
+
+	const uint8_t * recordData = data + LedFrameBlob::HEADER_SIZE;
+	for (int i = 0; i < header.count; i++, recordData += LedFrameBlob::RECORD_SIZE) {
+		int hourglassId = header.firstId + i;
+		HourGlass * hg = getHourglassById(hourglassId);
+		if (!hg) continue; // records beyond the installation are ignored
+
+		LedFrameBlob::Record record = LedFrameBlob::readRecord(recordData);
+		stageFrameSide(hourglassId, LedParameterStage::UP, record.up);
+		stageFrameSide(hourglassId, LedParameterStage::DOWN, record.down);
+
+		float luminosity = record.luminosity / 255.0f;
+		if (hg->individualLuminosity.get() != luminosity) {
+			hg->individualLuminosity.set(luminosity);
+			hg->refreshLedState();
+			if (uiWrapper && hourglassId == (uiWrapper->getCurrentHourGlass() + 1)) {
+				uiWrapper->updateCurrentIndividualLuminositySlider(luminosity);
+			}
+		}
+	}
+}
+
+void OSCController::stageFrameSide(int hourglassId, LedParameterStage::Side side, const LedFrameBlob::Side & values) {
+	size_t index = hourglassId - 1;
+	ledStage.stageColor(index, side, ofColor(values.r, values.g, values.b));
+	ledStage.stage(index, side, LedParameterStage::MAIN_LED, values.mainLed);
+	ledStage.stage(index, side, LedParameterStage::PWM, values.pwm);
+	ledStage.stage(index, side, LedParameterStage::BLEND, std::min<int>(values.blend, 768));
+	ledStage.stage(index, side, LedParameterStage::ORIGIN, std::min<int>(values.origin, 360));
+	ledStage.stage(index, side, LedParameterStage::ARC, std::min<int>(values.arc, 360));
+}
+
+void OSCController::handleSystemMotorPresetMessage(const OSCMessageView & msg) {
+	std::string_view address = msg.getAddress();
 	if (!OSCHelper::validateParameters(msg, 1, "system_motor_preset")) return;
-	std::string presetName = OSCHelper::getArgument<std::string>(msg, 0, "smooth");
+	std::string_view presetName = OSCHelper::getArgument<std::string_view>(msg, 0, "smooth");
 
 	int speed, accel;
 	if (lookupPreset(presetName, address, speed, accel)) {
@@ -576,127 +1080,61 @@ void OSCController::handleSystemMotorPresetMessage(ofxOscMessage & msg) {
 	}
 }
 
-void OSCController::handleSystemMotorConfigMessage(ofxOscMessage & msg, const std::vector<std::string> & addressParts) {
-	string address = msg.getAddress();
+void OSCController::handleSystemMotorConfigMessage(const OSCMessageView & msg, const OSCAddress & addressParts) {
+	std::string_view address = msg.getAddress();
 	if (addressParts.size() < 5) {
 		sendError(address, "Incomplete system motor config command. Expected /system/motor/config/{speed}/{accel}");
 		return;
 	}
-	try {
-		int speed_val = std::stoi(addressParts[3]);
-		int accel_val = std::stoi(addressParts[4]);
-
-		if (!OSCHelper::isValidMotorSpeed(speed_val) || !OSCHelper::isValidMotorAcceleration(accel_val)) {
-			OSCHelper::logError("system_motor_config", address, "Invalid speed/acceleration. Speed(0-500): " + ofToString(speed_val) + ", Accel(0-255): " + ofToString(accel_val));
-			return;
-		}
+	int speed_val = 0, accel_val = 0;
+	if (!addressParts.toInt(3, speed_val) || !addressParts.toInt(4, accel_val)) {
+		sendError(address, "Invalid number format for system motor config speed/accel");
+		return;
+	}
 
-		hourglassManager->forEachHourGlass([speed_val, accel_val](HourGlass & hg) {
-			applyMotorSpeedAccel(hg, speed_val, accel_val);
-		});
-	} catch (const std::exception & e) {
-		sendError(address, "Invalid number format for system motor config speed/accel: " + std::string(e.what()));
+	if (!OSCHelper::isValidMotorSpeed(speed_val) || !OSCHelper::isValidMotorAcceleration(accel_val)) {
+		OSCHelper::logError("system_motor_config", address, "Invalid speed/acceleration. Speed(0-500): " + ofToString(speed_val) + ", Accel(0-255): " + ofToString(accel_val));
+		return;
 	}
+
+	hourglassManager->forEachHourGlass([speed_val, accel_val](HourGlass & hg) {
+		applyMotorSpeedAccel(hg, speed_val, accel_val);
+	});
 }
 
-void OSCController::handleSystemMotorRotateMessage(ofxOscMessage & msg, const std::vector<std::string> & addressParts) {
+void OSCController::handleSystemMotorRotateMessage(const OSCMessageView & msg, const OSCAddress & addressParts) {
 	float degrees = 0.0f;
 	std::optional<int> speed_opt = std::nullopt;
 	std::optional<int> accel_opt = std::nullopt;
 	if (!parseAngleSpeedAccel(msg, addressParts, 3, "system_motor_rotate", degrees, speed_opt, accel_opt)) return;
 
-	hourglassManager->forEachHourGlass([&](HourGlass & hg) {
-		hg.commandRelativeAngle(degrees, speed_opt, accel_opt);
-	});
+	hourglassManager->rotateAll(degrees, speed_opt, accel_opt);
 }
 
-void OSCController::handleSystemMotorPositionMessage(ofxOscMessage & msg, const std::vector<std::string> & addressParts) {
+void OSCController::handleSystemMotorPositionMessage(const OSCMessageView & msg, const OSCAddress & addressParts) {
 	float degrees = 0.0f;
 	std::optional<int> speed_opt = std::nullopt;
 	std::optional<int> accel_opt = std::nullopt;
 	if (!parseAngleSpeedAccel(msg, addressParts, 3, "system_motor_position", degrees, speed_opt, accel_opt)) return;
 
-	hourglassManager->forEachHourGlass([&](HourGlass & hg) {
-		hg.commandAbsoluteAngle(degrees, speed_opt, accel_opt);
-	});
+	hourglassManager->moveAllToAngle(degrees, speed_opt, accel_opt);
 }
 
 // Utilities -----------------------------------------------------------------
 
-void OSCController::sendError(const string & originalAddress, const string & errorMessage) {
+void OSCController::sendError(std::string_view originalAddress, const std::string & errorMessage) {
 	OSCHelper::logError("OSCController", originalAddress, errorMessage);
 }
 
-int OSCController::extractHourglassId(const vector<string> & addressParts) {
-	if (addressParts.size() < 2) return -1;
-	try {
-		return std::stoi(addressParts[1]);
-	} catch (const std::exception &) {
-		return -1;
-	}
+int OSCController::extractHourglassId(const OSCAddress & addressParts) {
+	int id = -1;
+	return addressParts.toInt(1, id) ? id : -1;
 }
 
-std::vector<int> OSCController::extractHourglassIds(const vector<string> & addressParts) {
-	std::vector<int> ids;
-	if (addressParts.size() < 2) return ids;
-
-	std::string target = addressParts[1];
-
-	if (target == "all") {
-		for (int i = 1; i <= (int)hourglassManager->getHourGlassCount(); i++) {
-			ids.push_back(i);
-		}
-		return ids;
-	}
-
-	size_t commaPos = target.find(',');
-	if (commaPos != std::string::npos) {
-		std::string remaining = target;
-		while (!remaining.empty()) {
-			size_t nextComma = remaining.find(',');
-			std::string idStr = (nextComma != std::string::npos) ? remaining.substr(0, nextComma) : remaining;
-
-			try {
-				int id = std::stoi(idStr);
-				if (isValidHourglassId(id)) {
-					ids.push_back(id);
-				}
-			} catch (const std::exception &) {
-				// Invalid ID in comma list, skip this one
-			}
-
-			if (nextComma == std::string::npos) break;
-			remaining = remaining.substr(nextComma + 1);
-		}
-		return ids;
-	}
-
-	size_t dashPos = target.find('-');
-	if (dashPos != std::string::npos) {
-		try {
-			int start = std::stoi(target.substr(0, dashPos));
-			int end = std::stoi(target.substr(dashPos + 1));
-			if (start <= end && isValidHourglassId(start) && isValidHourglassId(end)) {
-				for (int i = start; i <= end; i++) {
-					ids.push_back(i);
-				}
-			}
-		} catch (const std::exception &) {
-			// Invalid range format, return empty
-		}
-		return ids;
-	}
-
-	try {
-		int id = std::stoi(target);
-		if (isValidHourglassId(id)) {
-			ids.push_back(id);
-		}
-	} catch (const std::exception &) {
-		// Invalid single ID
-	}
-
-	return ids;
+const HourglassTargetSet & OSCController::resolveTargets(const OSCAddress & addressParts) {
+	static const HourglassTargetSet kNoTargets;
+	if (addressParts.size() < 2) return kNoTargets;
+	return targetCache.get(addressParts[1]);
 }
 
 HourGlass * OSCController::getHourglassById(int id) {
@@ -713,7 +1151,7 @@ void OSCController::updateUIAngleParameters(float relativeAngle, float absoluteA
 }
 
 void OSCController::loadMotorPresets(const std::string & filename) {
-	static const std::map<std::string, std::pair<int, int>> kDefaultPresets = {
+	static const std::map<std::string, std::pair<int, int>, std::less<>> kDefaultPresets = {
 		{ "slow", { 50, 50 } },
 		{ "smooth", { 150, 100 } },
 		{ "medium", { 200, 150 } },
@@ -1,16 +1,29 @@
 #pragma once
 
 #include "HourGlassManager.h"
+#include "HourglassTargetSet.h"
+#include "LedParameterStage.h"
+#include "OSCAddress.h"
+#include "OSCBundleScheduler.h"
+#include "OSCCaptureLog.h"
+#include "OSCErrorLog.h"
 #include "OSCHelper.h"
+#include "OSCMessageView.h"
+#include "OSCReceiveThread.h"
+#include "OSCRouteTable.h"
 #include "ofMain.h"
 #include "ofxOsc.h"
 #include <map>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
-// Forward declaration
+// Forward declarations
 class UIWrapper;
+namespace LedFrameBlob {
+struct Side;
+}
 
 class OSCController {
 public:
@@ -22,6 +35,11 @@ public:
 	void update();
 	void shutdown();
 
+	// Apply LED values staged by this tick's messages (call once per tick,
+	// after every message source - network and sequencer - has been processed)
+	void commitStagedParameters();
+	const LedParameterStage & getLedStage() const { return ledStage; }
+
 	// Configuration
 	void setEnabled(bool enabled) { oscEnabled = enabled; }
 	bool isEnabled() const { return oscEnabled; }
@@ -29,28 +47,115 @@ public:
 	// UI synchronization
 	void setUIWrapper(UIWrapper * uiWrapper) { this->uiWrapper = uiWrapper; }
 
-	// OSC message handling
+	// OSC message handling (received packets are viewed in place; ofxOscMessage
+	// is encoded first, for the sequencer)
 	void processMessage(ofxOscMessage & message);
+	void processMessage(const OSCMessageView & message);
+
+	// Ingest statistics (receive thread -> frame loop)
+	struct IngestStats {
+		uint64_t received = 0; // datagrams seen by the receive thread
+		uint64_t dropped = 0; // ring full
+		uint64_t oversized = 0; // datagram larger than OSCPacket::MAX_SIZE
+		uint64_t malformed = 0; // rejected by the OSC parser
+		uint64_t handlerErrors = 0; // well-formed messages whose handler threw
+		uint64_t lastQueueDelayMicros = 0; // arrival -> dispatch of the last packet
+		uint64_t maxQueueDelayMicros = 0;
+	};
+	IngestStats getIngestStats() const;
+	// Arrival time of the packet currently being dispatched (0 outside update())
+	uint64_t getCurrentArrivalMicros() const { return currentArrivalMicros; }
+
+	// Capture received datagrams to a binary log, and feed a log back through
+	// the same dispatch path (in recorded timing, or all at once)
+	bool startCapture(const std::string & path);
+	void stopCapture();
+	bool isCapturing() const { return captureLog.isOpen(); }
+	bool startReplay(const std::string & path, bool realtime = true);
+	void stopReplay();
+	bool isReplaying() const { return replaying; }
+
+	// Aggregated OSC errors (first occurrence logged, repeats summarised)
+	OSCErrorLog & getErrorLog() { return errorLog; }
+	const OSCErrorLog & getErrorLog() const { return errorLog; }
+
+	// Bundles with future timetags: pending count and release lateness
+	const OSCBundleScheduler & getBundleScheduler() const { return bundleScheduler; }
+	uint64_t getTickPeriodMicros() const { return tickPeriodMicros; }
 
 	// Motor Presets
-	std::map<std::string, std::pair<int, int>> motorPresets;
+	std::map<std::string, std::pair<int, int>, std::less<>> motorPresets;
 	void loadMotorPresets(const std::string & filename = "motor_presets.json");
 
 	// Utility functions for hourglass targeting (1-based OSC ids)
-	int extractHourglassId(const std::vector<std::string> & addressParts);
-	std::vector<int> extractHourglassIds(const std::vector<std::string> & addressParts); // supports "all", "1,3" and "1-3" syntax
+	int extractHourglassId(const OSCAddress & addressParts);
+	const HourglassTargetSet & resolveTargets(const OSCAddress & addressParts); // "all", "3", "1,3", "1-3", "1,4-8,12"
 	HourGlass * getHourglassById(int id);
 	bool isValidHourglassId(int id);
 
-	// Helper functions for multi-hourglass LED operations
-	void handleIndividualLedMessageForHourglass(ofxOscMessage & msg, HourGlass * hg, const std::string & target, const std::string & command);
-	void handleAllLedMessageForHourglass(ofxOscMessage & msg, HourGlass * hg, const std::string & command, const std::vector<std::string> & addressParts);
-	void handlePWMMessageForHourglass(ofxOscMessage & msg, HourGlass * hg, const std::vector<std::string> & addressParts);
-	void handleMainLedMessageForHourglass(ofxOscMessage & msg, HourGlass * hg, const std::vector<std::string> & addressParts);
+	// Helper functions for multi-hourglass LED operations (values are staged, see commitStagedParameters)
+	void handleIndividualLedMessageForHourglass(const OSCMessageView & msg, int hourglassId, std::string_view target, std::string_view command);
+	void handleAllLedMessageForHourglass(const OSCMessageView & msg, int hourglassId, std::string_view command, const OSCAddress & addressParts);
+	void handlePWMMessageForHourglass(const OSCMessageView & msg, int hourglassId, const OSCAddress & addressParts);
+	void handleMainLedMessageForHourglass(const OSCMessageView & msg, int hourglassId, const OSCAddress & addressParts);
 
 private:
-	// OSC communication
-	ofxOscReceiver receiver;
+	// OSC communication: datagrams arrive on a dedicated thread, update() drains them
+	OSCReceiveThread receiveThread;
+	uint64_t currentArrivalMicros = 0;
+	uint32_t currentRemoteAddress = 0; // sender of the packet being dispatched (0 = not from the network)
+	int currentRemotePort = 0;
+	uint64_t malformedCount = 0;
+	uint64_t handlerErrorCount = 0;
+	uint64_t lastQueueDelayMicros = 0;
+	uint64_t maxQueueDelayMicros = 0;
+	void dispatchPacket(const char * data, std::size_t size);
+
+	// Capture / replay
+	OSCCaptureLog captureLog;
+	std::vector<char> replayBytes;
+	std::vector<OSCCaptureLog::Record> replayRecords;
+	size_t replayIndex = 0;
+	bool replaying = false;
+	bool replayRealtime = true;
+	uint64_t replayStartMicros = 0;
+	void updateReplay(uint64_t now);
+	void handleSystemCaptureMessage(const OSCMessageView & msg, const OSCAddress & addressParts);
+	// OSC capture/replay files are plain names under data/captures/; false for
+	// anything that could reach outside it (separators, "..", absolute paths)
+	static constexpr const char * CAPTURE_DIRECTORY = "captures";
+	static bool resolveCaptureFile(std::string_view name, std::string & path);
+
+	// Query replies (/system/errors, /system/stats) go back to the querying
+	// host, on the port given as the first argument or the sender's port
+	ofxOscSender replySender;
+	std::string replyHost;
+	int replyPort = 0;
+	bool setupReplySender(const OSCMessageView & msg);
+
+	// Error aggregation
+	OSCErrorLog errorLog;
+	void handleSystemErrorsMessage(const OSCMessageView & msg, const OSCAddress & addressParts);
+
+	// Per-destination egress counters, see OSCEgressService::Endpoint::Stats
+	void handleSystemStatsMessage(const OSCMessageView & msg);
+
+	// Timed bundles, released on the tick closest to their timetag
+	OSCBundleScheduler bundleScheduler;
+	uint64_t lastUpdateMicros = 0;
+	uint64_t tickPeriodMicros = 33333; // smoothed interval between update() calls
+
+	// Address routing, built once in the constructor
+	using RouteHandler = void (*)(OSCController &, const OSCMessageView &, const OSCAddress &);
+	OSCRouteTable<RouteHandler> routes;
+	void buildRoutes();
+	void reportUnroutedAddress(const OSCAddress & addressParts);
+
+	// Parsed target expressions (addressParts[1]) keyed by raw text
+	HourglassTargetCache targetCache;
+
+	// Latest LED values per (hourglass, side, field) for the current tick
+	LedParameterStage ledStage;
 
 	// System references
 	HourGlassManager * hourglassManager;
@@ -63,29 +168,32 @@ private:
 	int receivePort;
 
 	// Message handlers
-	void handleMotorMessage(ofxOscMessage & msg, const std::vector<std::string> & addressParts);
-	void handleLedMessage(ofxOscMessage & msg, const std::vector<std::string> & addressParts);
-	void handleSystemMessage(ofxOscMessage & msg, const std::vector<std::string> & addressParts);
-	void handleGlobalBlackoutMessage(ofxOscMessage & msg);
-	void handleGlobalLuminosityMessage(ofxOscMessage & msg);
-	void handleIndividualLuminosityMessage(ofxOscMessage & msg, const std::vector<std::string> & addressParts);
-	void handleSystemMotorPresetMessage(ofxOscMessage & msg);
-	void handleSystemMotorConfigMessage(ofxOscMessage & msg, const std::vector<std::string> & addressParts);
-	void handleSystemMotorRotateMessage(ofxOscMessage & msg, const std::vector<std::string> & addressParts);
-	void handleSystemMotorPositionMessage(ofxOscMessage & msg, const std::vector<std::string> & addressParts);
+	void handleMotorMessage(const OSCMessageView & msg, const OSCAddress & addressParts);
+	void handleLedMessage(const OSCMessageView & msg, const OSCAddress & addressParts);
+	void handleSystemMessage(const OSCMessageView & msg, const OSCAddress & addressParts);
+	void handleGlobalBlackoutMessage(const OSCMessageView & msg);
+	void handleGlobalLuminosityMessage(const OSCMessageView & msg);
+	void handleIndividualLuminosityMessage(const OSCMessageView & msg, const OSCAddress & addressParts);
+	void handleEffectMessage(const OSCMessageView & msg, const OSCAddress & addressParts);
+	void handleSystemMotorPresetMessage(const OSCMessageView & msg);
+	void handleSystemFrameMessage(const OSCMessageView & msg);
+	void stageFrameSide(int hourglassId, LedParameterStage::Side side, const LedFrameBlob::Side & values);
+	void handleSystemMotorConfigMessage(const OSCMessageView & msg, const OSCAddress & addressParts);
+	void handleSystemMotorRotateMessage(const OSCMessageView & msg, const OSCAddress & addressParts);
+	void handleSystemMotorPositionMessage(const OSCMessageView & msg, const OSCAddress & addressParts);
 
 	// Shared helpers
-	bool lookupPreset(const std::string & presetName, const std::string & address, int & speed, int & accel);
+	bool lookupPreset(std::string_view presetName, std::string_view address, int & speed, int & accel);
 	static void applyMotorSpeedAccel(HourGlass & hg, int speed, int accel);
-	bool parseAngleSpeedAccel(ofxOscMessage & msg, const std::vector<std::string> & addressParts, size_t angleIdx,
+	bool parseAngleSpeedAccel(const OSCMessageView & msg, const OSCAddress & addressParts, size_t angleIdx,
 		const std::string & context, float & degrees, std::optional<int> & speed, std::optional<int> & accel);
-	void setLedRangeParam(ofxOscMessage & msg, const std::string & context, int minValue, int maxValue, int defaultValue,
-		ofParameter<int> * upParam, ofParameter<int> * downParam);
-	void applyIndividualLuminosity(const std::vector<std::string> & addressParts, const std::string & address, float value);
+	void setLedRangeParam(const OSCMessageView & msg, const std::string & context, int minValue, int maxValue, int defaultValue,
+		int hourglassId, LedParameterStage::Field field, bool up, bool down);
+	void applyIndividualLuminosity(const OSCAddress & addressParts, std::string_view address, float value);
 
 	// UI parameter synchronization helpers
 	void updateUIAngleParameters(float relativeAngle, float absoluteAngle);
 
 	// Utility functions
-	void sendError(const std::string & originalAddress, const std::string & errorMessage);
+	void sendError(std::string_view originalAddress, const std::string & errorMessage);
 };
@@ -0,0 +1,540 @@
+#include "OSCEgressService.h"
+#include "OSCHelper.h"
+#include "OSCMessageView.h"
+#include "OscOutboundPacketStream.h"
+#include "ofMain.h"
+#include <algorithm>
+#include <random>
+
+#ifdef TARGET_LINUX
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+struct OSCEgressService::BatchScratch {
+#ifdef TARGET_LINUX
+	std::vector<mmsghdr> messages;
+	std::vector<iovec> buffers;
+	std::vector<sockaddr_in> addresses;
+	bool errorLogged = false;
+#endif
+};
+
+OSCEgressService::Endpoint::Endpoint(OSCEgressService & service, const std::string & host, int port)
+	: service(service)
+	, host(host)
+	, port(port) {
+	// Same socket setup as ofxOscSender (broadcast allowed)
+	try {
+		osc::IpEndpointName name(host.c_str(), port);
+		address = static_cast<uint32_t>(name.address);
+		socket = std::make_unique<osc::UdpTransmitSocket>(name);
+		socket->SetEnableBroadcast(true);
+	} catch (const std::exception & e) {
+		ofLogError("OSCEgressService") << "Cannot open sender to " << host << ":" << port << ": " << e.what();
+	}
+}
+
+void OSCEgressService::Endpoint::setRateLimit(const void * owner, const std::string & destination, int packetsPerSecond, int bytesPerSecond) {
+	std::pair<int, int> limit { std::max(0, packetsPerSecond), std::max(0, bytesPerSecond) };
+	auto key = std::make_pair(owner, destination);
+	auto it = rateLimits.find(key);
+	if (it != rateLimits.end() && it->second == limit) return;
+	rateLimits[key] = limit;
+	updateRateLimit();
+}
+
+void OSCEgressService::Endpoint::releaseRateLimit(const void * owner, const std::string & destination) {
+	if (rateLimits.erase(std::make_pair(owner, destination)) > 0) updateRateLimit();
+}
+
+// Strictest non-zero limit per bucket; buckets are only reconfigured when
+// their rate changes, and keep their tokens when they do
+void OSCEgressService::Endpoint::updateRateLimit() {
+	int packetsPerSecond = 0;
+	int bytesPerSecond = 0;
+	for (const auto & entry : rateLimits) {
+		const std::pair<int, int> & limit = entry.second;
+		if (limit.first > 0 && (packetsPerSecond == 0 || limit.first < packetsPerSecond)) packetsPerSecond = limit.first;
+		if (limit.second > 0 && (bytesPerSecond == 0 || limit.second < bytesPerSecond)) bytesPerSecond = limit.second;
+	}
+	if (packetBucket.getRate() != packetsPerSecond) {
+		packetBucket.configure(packetsPerSecond, std::max(1.0, packetsPerSecond * RATE_BURST_SECONDS));
+	}
+	if (byteBucket.getRate() != bytesPerSecond) {
+		byteBucket.configure(bytesPerSecond, std::max<double>(MAX_DATAGRAM_SIZE, bytesPerSecond * RATE_BURST_SECONDS));
+	}
+}
+
+bool OSCEgressService::Endpoint::tryConsume(size_t size, double now) {
+	packetBucket.refill(now);
+	byteBucket.refill(now);
+	if (!packetBucket.canConsume(1.0) || !byteBucket.canConsume(static_cast<double>(size))) return false;
+	packetBucket.consume(1.0);
+	byteBucket.consume(static_cast<double>(size));
+	return true;
+}
+
+void OSCEgressService::Endpoint::sendMessage(const ofxOscMessage & message) {
+	char buffer[MAX_PACKET_SIZE];
+	osc::OutboundPacketStream stream(buffer, sizeof(buffer));
+	try {
+		stream << osc::BeginBundleImmediate;
+		OSCHelper::encodeMessage(message, stream);
+		stream << osc::EndBundle;
+	} catch (const osc::Exception & e) {
+		OSCHelper::logError("sendMessage", message.getAddress(), std::string("Cannot encode message: ") + e.what());
+		return;
+	}
+	sendPacket(stream.Data(), stream.Size());
+}
+
+void OSCEgressService::Endpoint::sendPacket(const char * data, size_t size) {
+	if (!socket) return;
+	std::lock_guard<std::mutex> lock(sendMutex);
+	service.datagramCount++;
+	service.syscallCount++;
+	auto start = std::chrono::steady_clock::now();
+	try {
+		socket->Send(data, size);
+	} catch (const std::exception & e) {
+		if (errorCount++ == 0) {
+			ofLogError("OSCEgressService") << "Send to " << host << ":" << port << " failed: " << e.what();
+		}
+		return;
+	}
+	countSent(size, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+void OSCEgressService::Endpoint::countSent(size_t size, uint64_t callMicros) {
+	packetCount++;
+	byteCount += size;
+	sendLatency.record(callMicros);
+}
+
+OSCEgressService::Endpoint::Stats OSCEgressService::Endpoint::getStats() const {
+	Stats stats;
+	stats.packets = packetCount;
+	stats.bytes = byteCount;
+	stats.errors = errorCount;
+	stats.coalesced = coalescedCount;
+	stats.dropped = droppedCount;
+	stats.queuedRepeats = queuedRepeatCount;
+	stats.packetsPerSecond = packetsPerSecond;
+	stats.bytesPerSecond = bytesPerSecond;
+	stats.sendLatencyP50Micros = sendLatency.percentile(0.5);
+	stats.sendLatencyP99Micros = sendLatency.percentile(0.99);
+	stats.sendLatencyMaxMicros = sendLatency.getMax();
+	return stats;
+}
+
+OSCEgressService & OSCEgressService::instance() {
+	static OSCEgressService service;
+	return service;
+}
+
+OSCEgressService::OSCEgressService()
+	: batch(std::make_unique<BatchScratch>()) {
+	// Random start, so a restarted controller does not reuse sequence numbers
+	// a receiver may still remember
+	nextSequence = static_cast<int32_t>(std::random_device {}() & 0x3fffffff);
+#ifdef TARGET_LINUX
+	batchSocket = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	int broadcast = 1;
+	if (batchSocket >= 0 && setsockopt(batchSocket, SOL_SOCKET, SO_BROADCAST, &broadcast, sizeof(broadcast)) < 0) {
+		::close(batchSocket);
+		batchSocket = -1;
+	}
+	if (batchSocket < 0) {
+		ofLogWarning("OSCEgressService") << "No batch socket (" << std::strerror(errno) << "), sending one datagram per call";
+	}
+#endif
+	running = true;
+	ioThread = std::thread(&OSCEgressService::run, this);
+}
+
+OSCEgressService::~OSCEgressService() {
+	if (ackSocket) ackSocket->AsynchronousBreak();
+	if (ackThread.joinable()) ackThread.join();
+	{
+		std::lock_guard<std::mutex> lock(repeatMutex);
+		running = false;
+	}
+	repeatCv.notify_all();
+	if (ioThread.joinable()) {
+		ioThread.join();
+	}
+#ifdef TARGET_LINUX
+	if (batchSocket >= 0) ::close(batchSocket);
+#endif
+}
+
+std::shared_ptr<OSCEgressService::Endpoint> OSCEgressService::acquire(const std::string & host, int port) {
+	std::lock_guard<std::mutex> lock(endpointMutex);
+	std::string key = host + ":" + ofToString(port);
+	auto it = endpoints.find(key);
+	if (it != endpoints.end()) {
+		if (auto endpoint = it->second.lock()) return endpoint;
+	}
+
+	auto endpoint = std::make_shared<Endpoint>(*this, host, port);
+	endpoints[key] = endpoint;
+	return endpoint;
+}
+
+void OSCEgressService::scheduleRepeats(const std::shared_ptr<Endpoint> & endpoint, const ofxOscMessage & message, int count, int intervalMs) {
+	if (!endpoint || count <= 0) return;
+	auto interval = std::chrono::milliseconds(intervalMs);
+	bool earliest;
+	{
+		std::lock_guard<std::mutex> lock(repeatMutex);
+		auto due = std::chrono::steady_clock::now() + interval;
+		earliest = repeats.empty() || due < repeats.nextDue();
+		repeats.push(PendingRepeat { endpoint, message }, count, interval, due);
+		endpoint->queuedRepeatCount += count;
+	}
+	// The I/O thread only needs waking when its current deadline moved earlier
+	if (earliest) repeatCv.notify_all();
+}
+
+int32_t OSCEgressService::sendAcknowledged(const std::shared_ptr<Endpoint> & endpoint, const ofxOscMessage & message) {
+	if (!endpoint) return 0;
+	auto now = std::chrono::steady_clock::now();
+	bool earliest;
+	int32_t sequence;
+	ofxOscMessage sequenced = message;
+	{
+		// Registered before the send, so an early ack finds it; the send
+		// itself happens outside the lock
+		std::lock_guard<std::mutex> lock(repeatMutex);
+		sequence = nextSequence;
+		nextSequence = (nextSequence == INT32_MAX) ? 1 : nextSequence + 1;
+
+		sequenced.addInt32Arg(sequence);
+		InFlight entry { endpoint, sequenced, now, 1, ackTimeout() };
+
+		auto due = now + entry.timeout;
+		earliest = (repeats.empty() || due < repeats.nextDue()) && (ackTimeouts.empty() || due < ackTimeouts.nextDue());
+		ackTimeouts.push(sequence, 1, entry.timeout, due);
+		inFlight[sequence] = std::move(entry);
+		ackStats.sent++;
+		endpoint->queuedRepeatCount++;
+	}
+	endpoint->sendMessage(sequenced);
+	if (earliest) repeatCv.notify_all();
+	return sequence;
+}
+
+bool OSCEgressService::startAckListener(int port) {
+	if (ackSocket) {
+		if (port == ackPort) return true;
+		ofLogWarning("OSCEgressService") << "Ack listener already on port " << ackPort << ", not opening " << port;
+		return false;
+	}
+
+	try {
+		ackSocket = std::make_unique<osc::UdpListeningReceiveSocket>(
+			osc::IpEndpointName(osc::IpEndpointName::ANY_ADDRESS, port), &ackListener);
+	} catch (const std::exception & e) {
+		ofLogError("OSCEgressService") << "Cannot listen for acks on port " << port << ": " << e.what();
+		ackSocket.reset();
+		return false;
+	}
+	ackPort = port;
+	ackThread = std::thread([this] {
+		try {
+			ackSocket->Run();
+		} catch (const std::exception & e) {
+			ofLogError("OSCEgressService") << "Ack listener stopped: " << e.what();
+		}
+	});
+	return true;
+}
+
+OSCEgressService::AckStats OSCEgressService::getAckStats() {
+	std::lock_guard<std::mutex> lock(repeatMutex);
+	AckStats stats = ackStats;
+	stats.inFlight = inFlight.size();
+	return stats;
+}
+
+// Twice the smoothed RTT once one is known
+std::chrono::steady_clock::duration OSCEgressService::ackTimeout() const {
+	if (ackStats.smoothedRttMs <= 0.0f) return std::chrono::milliseconds(ACK_INITIAL_TIMEOUT_MS);
+	float ms = std::clamp(2.0f * ackStats.smoothedRttMs, float(ACK_MIN_TIMEOUT_MS), float(ACK_MAX_TIMEOUT_MS));
+	return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float, std::milli>(ms));
+}
+
+// Under repeatMutex: queues the resend (or the expiry warning) for run() to
+// send / log once the lock is released
+void OSCEgressService::retransmit(int32_t sequence, std::chrono::steady_clock::time_point now) {
+	auto it = inFlight.find(sequence);
+	if (it == inFlight.end()) return; // acked since the timeout was set
+	InFlight & entry = it->second;
+
+	if (entry.sends >= ACK_MAX_SENDS) {
+		expiredWarnings.push_back("No ack for " + entry.message.getAddress() + " #" + ofToString(sequence)
+			+ " from " + entry.endpoint->getHost() + ":" + ofToString(entry.endpoint->getPort())
+			+ " after " + ofToString(entry.sends) + " sends");
+		ackStats.expired++;
+		entry.endpoint->queuedRepeatCount--;
+		entry.endpoint->countDropped(1);
+		inFlight.erase(it);
+		return;
+	}
+
+	outgoing.push_back(PendingRepeat { entry.endpoint, entry.message });
+	entry.sends++;
+	entry.timeout = std::min<std::chrono::steady_clock::duration>(entry.timeout * 2, std::chrono::milliseconds(ACK_MAX_TIMEOUT_MS));
+	ackTimeouts.push(sequence, 1, entry.timeout, now + entry.timeout);
+	ackStats.retransmits++;
+}
+
+void OSCEgressService::acknowledge(int32_t sequence) {
+	auto now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> lock(repeatMutex);
+	auto it = inFlight.find(sequence);
+	if (it == inFlight.end()) {
+		ackStats.unmatchedAcks++;
+		return;
+	}
+
+	// An ack after a retransmit cannot be matched to one send, so only
+	// first-send round trips feed the estimate
+	if (it->second.sends == 1) {
+		float rttMs = std::chrono::duration<float, std::milli>(now - it->second.firstSent).count();
+		ackStats.lastRttMs = rttMs;
+		ackStats.smoothedRttMs = (ackStats.smoothedRttMs <= 0.0f) ? rttMs : 0.875f * ackStats.smoothedRttMs + 0.125f * rttMs;
+	}
+	ackStats.acked++;
+	it->second.endpoint->queuedRepeatCount--;
+	inFlight.erase(it);
+}
+
+void OSCEgressService::AckListener::ProcessPacket(const char * data, int size, const osc::IpEndpointName &) {
+	if (size > 0) service.handleAckPacket(data, static_cast<size_t>(size));
+}
+
+// "/ack <int32 sequence>", alone or inside (nested) bundles
+void OSCEgressService::handleAckPacket(const char * data, size_t size) {
+	static constexpr char BUNDLE_TAG[8] = { '#', 'b', 'u', 'n', 'd', 'l', 'e', 0 };
+	if (size >= 16 && std::equal(BUNDLE_TAG, BUNDLE_TAG + 8, data)) {
+		for (size_t pos = 16; pos + 4 <= size;) {
+			const unsigned char * sizeBytes = reinterpret_cast<const unsigned char *>(data + pos);
+			size_t elementSize = (size_t(sizeBytes[0]) << 24) | (size_t(sizeBytes[1]) << 16) | (size_t(sizeBytes[2]) << 8) | size_t(sizeBytes[3]);
+			if (elementSize > size - pos - 4) return;
+			handleAckPacket(data + pos + 4, elementSize);
+			pos += 4 + elementSize;
+		}
+		return;
+	}
+
+	OSCMessageView message;
+	if (!message.parse(data, size) || message.getAddress() != "/ack") return;
+	if (message.getArgType(0) != 'i') return;
+	acknowledge(message.getInt32(0));
+}
+
+void OSCEgressService::queuePacket(const std::shared_ptr<Endpoint> & endpoint, const char * data, size_t size) {
+	if (!endpoint || !endpoint->socket) return;
+	queuedPackets.push_back(QueuedPacket { endpoint, queuedBytes.size(), size });
+	queuedBytes.insert(queuedBytes.end(), data, data + size);
+}
+
+void OSCEgressService::flushPackets() {
+	size_t next = 0;
+	bool batchFailed = false;
+	while (next < queuedPackets.size()) {
+		const QueuedPacket & packet = queuedPackets[next];
+		size_t sent = 0;
+		if (!batchFailed && packet.endpoint->address != 0) {
+			sent = sendBatch(next, queuedPackets.size() - next);
+			// A failed batch would likely fail again: the rest of this tick goes
+			// out per datagram instead of paying for two calls each
+			batchFailed = sent == 0;
+		}
+		if (sent == 0) {
+			// No batch path, or it failed: send this one on its own socket
+			packet.endpoint->sendPacket(queuedBytes.data() + packet.offset, packet.size);
+			sent = 1;
+		}
+		next += sent;
+	}
+	queuedPackets.clear();
+	queuedBytes.clear();
+
+	auto now = std::chrono::steady_clock::now();
+	if (now - lastRateUpdate >= std::chrono::duration<double>(STATS_RATE_INTERVAL)) {
+		updateRates(now);
+	}
+
+	uint64_t datagrams = datagramCount;
+	uint64_t syscalls = syscallCount;
+	lastTickDatagrams = datagrams - tickStartDatagrams;
+	lastTickSyscalls = syscalls - tickStartSyscalls;
+	tickStartDatagrams = datagrams;
+	tickStartSyscalls = syscalls;
+	ticks++;
+}
+
+// Sends queued packets from `first` (stopping before any unresolved endpoint)
+// with one sendmmsg(); returns how many went out, 0 if none did
+size_t OSCEgressService::sendBatch(size_t first, size_t count) {
+#ifdef TARGET_LINUX
+	if (batchSocket < 0) return 0;
+	count = std::min(count, MAX_BATCH);
+	if (batch->messages.size() < count) {
+		batch->messages.resize(count);
+		batch->buffers.resize(count);
+		batch->addresses.resize(count);
+	}
+
+	size_t n = 0;
+	for (; n < count; n++) {
+		const QueuedPacket & packet = queuedPackets[first + n];
+		if (packet.endpoint->address == 0) break;
+		sockaddr_in & to = batch->addresses[n];
+		std::memset(&to, 0, sizeof(to));
+		to.sin_family = AF_INET;
+		to.sin_addr.s_addr = htonl(packet.endpoint->address);
+		to.sin_port = htons(static_cast<uint16_t>(packet.endpoint->port));
+		batch->buffers[n].iov_base = queuedBytes.data() + packet.offset;
+		batch->buffers[n].iov_len = packet.size;
+		mmsghdr & message = batch->messages[n];
+		std::memset(&message, 0, sizeof(message));
+		message.msg_hdr.msg_name = &to;
+		message.msg_hdr.msg_namelen = sizeof(to);
+		message.msg_hdr.msg_iov = &batch->buffers[n];
+		message.msg_hdr.msg_iovlen = 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	int sent = sendmmsg(batchSocket, batch->messages.data(), static_cast<unsigned int>(n), 0);
+	uint64_t callMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	syscallCount++;
+	if (sent <= 0) {
+		queuedPackets[first].endpoint->errorCount++;
+		if (!batch->errorLogged) {
+			ofLogWarning("OSCEgressService") << "sendmmsg failed (" << std::strerror(errno) << "), sending per datagram for the rest of the tick";
+			batch->errorLogged = true;
+		}
+		return 0;
+	}
+	datagramCount += static_cast<uint64_t>(sent);
+	for (int i = 0; i < sent; i++) {
+		const QueuedPacket & packet = queuedPackets[first + i];
+		packet.endpoint->countSent(packet.size, callMicros);
+	}
+	return static_cast<size_t>(sent);
+#else
+	return 0;
+#endif
+}
+
+OSCEgressService::Stats OSCEgressService::getStats() const {
+	Stats stats;
+	stats.ticks = ticks;
+	stats.datagrams = datagramCount;
+	stats.syscalls = syscallCount;
+	stats.lastTickDatagrams = lastTickDatagrams;
+	stats.lastTickSyscalls = lastTickSyscalls;
+	stats.batched = batchSocket >= 0;
+	return stats;
+}
+
+void OSCEgressService::updateRates(std::chrono::steady_clock::time_point now) {
+	float elapsed = std::chrono::duration<float>(now - lastRateUpdate).count();
+	bool first = lastRateUpdate == std::chrono::steady_clock::time_point();
+	lastRateUpdate = now;
+	for (const auto & endpoint : getEndpoints()) {
+		uint64_t packets = endpoint->packetCount;
+		uint64_t bytes = endpoint->byteCount;
+		if (!first) {
+			endpoint->packetsPerSecond = (packets - endpoint->ratePackets) / elapsed;
+			endpoint->bytesPerSecond = (bytes - endpoint->rateBytes) / elapsed;
+		}
+		endpoint->ratePackets = packets;
+		endpoint->rateBytes = bytes;
+	}
+}
+
+std::vector<std::shared_ptr<OSCEgressService::Endpoint>> OSCEgressService::getEndpoints() {
+	std::lock_guard<std::mutex> lock(endpointMutex);
+	std::vector<std::shared_ptr<Endpoint>> live;
+	for (const auto & entry : endpoints) {
+		if (auto endpoint = entry.second.lock()) live.push_back(endpoint);
+	}
+	return live;
+}
+
+size_t OSCEgressService::getEndpointCount() {
+	std::lock_guard<std::mutex> lock(endpointMutex);
+	size_t count = 0;
+	for (auto it = endpoints.begin(); it != endpoints.end();) {
+		if (it->second.expired()) {
+			it = endpoints.erase(it);
+		} else {
+			count++;
+			++it;
+		}
+	}
+	return count;
+}
+
+size_t OSCEgressService::getPendingRepeatCount() {
+	std::lock_guard<std::mutex> lock(repeatMutex);
+	return repeats.size();
+}
+
+void OSCEgressService::run() {
+	std::unique_lock<std::mutex> lock(repeatMutex);
+	while (running) {
+		if (repeats.empty() && ackTimeouts.empty()) {
+			repeatCv.wait(lock, [this] { return !running || !repeats.empty() || !ackTimeouts.empty(); });
+			continue;
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		auto nextDue = repeats.empty() ? ackTimeouts.nextDue()
+			: ackTimeouts.empty()      ? repeats.nextDue()
+									   : std::min(repeats.nextDue(), ackTimeouts.nextDue());
+		if (nextDue > now + REPEAT_HORIZON) {
+			repeatCv.wait_until(lock, nextDue - REPEAT_HORIZON);
+			continue; // re-evaluate: earlier entries or shutdown may have arrived
+		}
+
+		repeats.runDue(now, REPEAT_HORIZON, [this](PendingRepeat & pending, std::chrono::steady_clock::time_point) {
+			outgoing.push_back(pending);
+			pending.endpoint->queuedRepeatCount--;
+		});
+
+		// Retransmits push new timeouts, so they run after the heap walk
+		ackTimeouts.runDue(now, REPEAT_HORIZON, [this](int32_t & sequence, std::chrono::steady_clock::time_point) {
+			timedOut.push_back(sequence);
+		});
+		for (int32_t sequence : timedOut) {
+			retransmit(sequence, now);
+		}
+		timedOut.clear();
+
+		// Sends (which may block) and logging happen unlocked, so they never
+		// hold up scheduleRepeats(), sendAcknowledged() or acknowledge()
+		if (outgoing.empty() && expiredWarnings.empty()) continue;
+		std::swap(outgoing, sending);
+		std::swap(expiredWarnings, logging);
+		lock.unlock();
+		for (const PendingRepeat & pending : sending) {
+			pending.endpoint->sendMessage(pending.message);
+		}
+		for (const std::string & text : logging) {
+			ofLogWarning("OSCEgressService") << text;
+		}
+		sending.clear();
+		logging.clear();
+		lock.lock();
+	}
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "LatencyHistogram.h"
+#include "PacketListener.h"
+#include "RepeatScheduler.h"
+#include "TokenBucket.h"
+#include "UdpSocket.h"
+#include "ofxOsc.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Process-wide OSC egress: one UDP sender per ip:port shared by every
+// OSCOutController that targets it, and a single I/O thread that times motor
+// repeats for the whole installation. Controllers only hold Endpoint handles,
+// so thread count stays at one however many hourglasses are configured.
+class OSCEgressService {
+public:
+	// One shared socket. Sends are serialised per endpoint, so the frame thread
+	// and the I/O thread can both use it.
+	class Endpoint {
+	public:
+		Endpoint(OSCEgressService & service, const std::string & host, int port);
+
+		// Wrapped in an immediate bundle, as ofxOscSender sends it
+		void sendMessage(const ofxOscMessage & message);
+		// Already-encoded OSC packet (message or bundle), sent as one datagram
+		void sendPacket(const char * data, size_t size);
+
+		const std::string & getHost() const { return host; }
+		int getPort() const { return port; }
+
+		// Pacing for frame (LED) datagrams, frame thread only; motor and
+		// emergency sends bypass it. 0 means unlimited. Bursts of up to
+		// RATE_BURST_SECONDS worth of traffic (at least one full datagram)
+		// pass unthrottled. The endpoint is shared by every controller sending
+		// to its ip:port, so each registers its own limit under (owner,
+		// destination name); the effective limit is the strictest non-zero one
+		// among the registrations and follows them as they change or go away.
+		void setRateLimit(const void * owner, const std::string & destination, int packetsPerSecond, int bytesPerSecond);
+		void releaseRateLimit(const void * owner, const std::string & destination);
+		bool isRateLimited() const { return packetBucket.isLimited() || byteBucket.isLimited(); }
+		// Takes the tokens for one datagram of `size` bytes if both buckets have them
+		bool tryConsume(size_t size, double now);
+		static constexpr double RATE_BURST_SECONDS = 0.1;
+
+		// Counters for this ip:port, from every controller and thread
+		struct Stats {
+			uint64_t packets = 0; // datagrams handed to the kernel
+			uint64_t bytes = 0;
+			uint64_t errors = 0; // failed send calls
+			uint64_t coalesced = 0; // paced LED updates overwritten before sending
+			uint64_t dropped = 0; // updates discarded unsent (held when disabled, expired acks)
+			int64_t queuedRepeats = 0; // repeat sends still scheduled + unacknowledged commands
+			float packetsPerSecond = 0.0f; // over the last STATS_RATE_INTERVAL
+			float bytesPerSecond = 0.0f;
+			uint64_t sendLatencyP50Micros = 0; // duration of the send call carrying each datagram
+			uint64_t sendLatencyP99Micros = 0;
+			uint64_t sendLatencyMaxMicros = 0;
+		};
+		Stats getStats() const;
+		const LatencyHistogram & getSendLatency() const { return sendLatency; }
+		void countCoalesced(uint64_t count) { coalescedCount += count; }
+		void countDropped(uint64_t count) { droppedCount += count; }
+
+		static constexpr size_t MAX_PACKET_SIZE = 4096;
+
+	private:
+		friend class OSCEgressService;
+		OSCEgressService & service;
+		std::mutex sendMutex;
+		std::unique_ptr<osc::UdpTransmitSocket> socket; // null if host:port did not resolve
+		std::string host;
+		int port;
+		uint32_t address = 0; // IPv4, host byte order; 0 if not resolved
+		TokenBucket packetBucket;
+		TokenBucket byteBucket;
+		std::map<std::pair<const void *, std::string>, std::pair<int, int>> rateLimits; // packets/s, bytes/s
+		void updateRateLimit();
+
+		std::atomic<uint64_t> packetCount { 0 };
+		std::atomic<uint64_t> byteCount { 0 };
+		std::atomic<uint64_t> errorCount { 0 };
+		std::atomic<uint64_t> coalescedCount { 0 };
+		std::atomic<uint64_t> droppedCount { 0 };
+		std::atomic<int64_t> queuedRepeatCount { 0 };
+		LatencyHistogram sendLatency;
+		void countSent(size_t size, uint64_t callMicros);
+		// Rates, frame thread only (updated from flushPackets())
+		uint64_t ratePackets = 0;
+		uint64_t rateBytes = 0;
+		float packetsPerSecond = 0.0f;
+		float bytesPerSecond = 0.0f;
+	};
+
+	static OSCEgressService & instance();
+	~OSCEgressService();
+	OSCEgressService(const OSCEgressService &) = delete;
+	OSCEgressService & operator=(const OSCEgressService &) = delete;
+
+	// Shared endpoint for host:port; the socket closes when the last handle goes
+	std::shared_ptr<Endpoint> acquire(const std::string & host, int port);
+
+	// Send message `count` more times on endpoint, intervalMs apart, from the I/O thread
+	void scheduleRepeats(const std::shared_ptr<Endpoint> & endpoint, const ofxOscMessage & message, int count, int intervalMs);
+
+	// Acknowledged sends (reliable motor mode): the message gets a trailing
+	// int32 sequence number, one per call, and is retransmitted with doubling
+	// timeouts until "/ack <sequence>" arrives on the reply port or
+	// ACK_MAX_SENDS is reached. Receivers must apply each sequence number at
+	// most once, since a retransmit may cross the ack of an earlier send.
+	// Returns the sequence number.
+	int32_t sendAcknowledged(const std::shared_ptr<Endpoint> & endpoint, const ofxOscMessage & message);
+
+	// One reply port for the whole process; false if it cannot be opened, or
+	// the listener already runs on another port
+	bool startAckListener(int port);
+	int getAckListenerPort() const { return ackPort; }
+
+	static constexpr int ACK_INITIAL_TIMEOUT_MS = 20; // until an RTT has been measured
+	static constexpr int ACK_MIN_TIMEOUT_MS = 5;
+	static constexpr int ACK_MAX_TIMEOUT_MS = 500;
+	static constexpr int ACK_MAX_SENDS = 6;
+
+	struct AckStats {
+		size_t inFlight = 0;
+		uint64_t sent = 0; // acknowledged commands issued (one per destination)
+		uint64_t acked = 0;
+		uint64_t retransmits = 0;
+		uint64_t expired = 0; // gave up after ACK_MAX_SENDS
+		uint64_t unmatchedAcks = 0; // duplicate, late or unknown sequence numbers
+		float lastRttMs = 0.0f; // first-send samples only (Karn's rule)
+		float smoothedRttMs = 0.0f;
+	};
+	AckStats getAckStats();
+
+	// Frame-thread datagram batch: queuePacket() copies the datagram, and
+	// flushPackets() sends everything queued this tick. On Linux that is one
+	// sendmmsg() call per MAX_BATCH datagrams from a shared socket; elsewhere,
+	// or after a batch send fails (until the next tick), each datagram goes out
+	// on its endpoint's own socket. Call flushPackets() once at the end of every tick.
+	void queuePacket(const std::shared_ptr<Endpoint> & endpoint, const char * data, size_t size);
+	void flushPackets();
+	static constexpr size_t MAX_BATCH = 1024; // Linux UIO_MAXIOV
+	static constexpr size_t MAX_DATAGRAM_SIZE = 1472; // Ethernet MTU - IPv4 - UDP headers
+
+	struct Stats {
+		uint64_t ticks = 0; // flushPackets() calls
+		uint64_t datagrams = 0; // every send, batched or not
+		uint64_t syscalls = 0; // send system calls they took
+		uint64_t lastTickDatagrams = 0;
+		uint64_t lastTickSyscalls = 0; // includes motor sends and repeats since the previous tick
+		bool batched = false; // sendmmsg fast path available
+	};
+	Stats getStats() const; // frame thread
+
+	// Repeats due this close together are sent on the same I/O thread wake-up
+	static constexpr std::chrono::microseconds REPEAT_HORIZON { 200 };
+
+	size_t getEndpointCount();
+	// Live endpoints ordered by "ip:port", for per-destination stats
+	std::vector<std::shared_ptr<Endpoint>> getEndpoints();
+	static constexpr double STATS_RATE_INTERVAL = 1.0; // seconds
+	size_t getPendingRepeatCount();
+
+private:
+	OSCEgressService();
+
+	std::mutex endpointMutex;
+	std::map<std::string, std::weak_ptr<Endpoint>> endpoints; // keyed by "ip:port"
+
+	struct QueuedPacket {
+		std::shared_ptr<Endpoint> endpoint;
+		size_t offset; // into queuedBytes
+		size_t size;
+	};
+	struct PendingRepeat {
+		std::shared_ptr<Endpoint> endpoint;
+		ofxOscMessage message;
+	};
+	struct InFlight {
+		std::shared_ptr<Endpoint> endpoint;
+		ofxOscMessage message; // with the sequence number
+		std::chrono::steady_clock::time_point firstSent;
+		int sends = 1;
+		std::chrono::steady_clock::duration timeout;
+	};
+	std::vector<QueuedPacket> queuedPackets; // frame thread only
+	std::vector<char> queuedBytes;
+	struct BatchScratch; // platform send structures, reused across ticks
+	std::unique_ptr<BatchScratch> batch;
+	int batchSocket = -1;
+	size_t sendBatch(size_t first, size_t count);
+
+	std::atomic<uint64_t> ticks { 0 };
+	std::atomic<uint64_t> datagramCount { 0 };
+	std::atomic<uint64_t> syscallCount { 0 };
+	uint64_t lastTickDatagrams = 0;
+	uint64_t lastTickSyscalls = 0;
+	uint64_t tickStartDatagrams = 0;
+	uint64_t tickStartSyscalls = 0;
+	std::chrono::steady_clock::time_point lastRateUpdate;
+	void updateRates(std::chrono::steady_clock::time_point now);
+
+	std::thread ioThread;
+	std::mutex repeatMutex;
+	std::condition_variable repeatCv;
+	RepeatScheduler<PendingRepeat> repeats;
+	bool running = false; // guarded by repeatMutex
+	void run();
+
+	// Acknowledged sends, guarded by repeatMutex
+	std::unordered_map<int32_t, InFlight> inFlight;
+	RepeatScheduler<int32_t> ackTimeouts; // one entry per outstanding send, by sequence number
+	std::vector<int32_t> timedOut; // scratch for run()
+	// Due repeats / retransmits and expiry warnings, collected under the lock
+	// and sent / logged by run() after releasing it
+	std::vector<PendingRepeat> outgoing;
+	std::vector<std::string> expiredWarnings;
+	std::vector<PendingRepeat> sending; // I/O thread only
+	std::vector<std::string> logging;
+	int32_t nextSequence = 1;
+	AckStats ackStats;
+	std::chrono::steady_clock::duration ackTimeout() const;
+	void retransmit(int32_t sequence, std::chrono::steady_clock::time_point now);
+	void acknowledge(int32_t sequence);
+
+	// Reply port listener thread
+	class AckListener : public osc::PacketListener {
+	public:
+		explicit AckListener(OSCEgressService & service)
+			: service(service) { }
+		void ProcessPacket(const char * data, int size, const osc::IpEndpointName & remoteEndpoint) override;
+
+	private:
+		OSCEgressService & service;
+	};
+	AckListener ackListener { *this };
+	std::unique_ptr<osc::UdpListeningReceiveSocket> ackSocket;
+	std::thread ackThread;
+	int ackPort = 0;
+	void handleAckPacket(const char * data, size_t size);
+};
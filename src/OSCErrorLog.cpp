@@ -0,0 +1,108 @@
+#include "OSCErrorLog.h"
+#include "ofMain.h"
+#include <algorithm>
+#include <cstring>
+
+void OSCErrorLog::report(std::string_view kind, std::string_view address, std::string_view message, double now) {
+	std::lock_guard<std::mutex> lock(mutex);
+	stats.reported++;
+
+	uint32_t hash = hashKey(kind, address);
+	Entry * entry = find(hash, kind, address);
+	bool isNew = entry == nullptr;
+	if (isNew) entry = &insert(hash, kind, address, now);
+
+	entry->count++;
+	entry->lastSeen = now;
+	copyTruncated(entry->message, message);
+
+	if (isNew && firstLogsThisInterval < FIRST_LOG_BUDGET) {
+		firstLogsThisInterval++;
+		stats.logged++;
+		ofLogError("OSCHelper::" + std::string(kind)) << "[" << address << "]: " << message;
+	} else {
+		entry->pending++;
+	}
+}
+
+void OSCErrorLog::update(double now) {
+	std::lock_guard<std::mutex> lock(mutex);
+	if (now - lastSummary < summaryInterval) return;
+	double window = lastSummary > 0.0 ? now - lastSummary : now;
+	lastSummary = now;
+	firstLogsThisInterval = 0;
+
+	for (std::size_t i = 0; i < size; i++) {
+		const Entry & entry = entries[(head + i) % CAPACITY];
+		if (entry.pending == 0) continue;
+		stats.summaries++;
+		ofLogError("OSCHelper::" + std::string(entry.kind)) << "[" << entry.address << "]: " << entry.message
+															<< " (x" << entry.pending << " in last " << ofToString(window, 1) << " s, "
+															<< entry.count << " total)";
+	}
+	for (Entry & entry : entries) {
+		entry.pending = 0;
+	}
+}
+
+void OSCErrorLog::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	head = 0;
+	size = 0;
+	for (Entry & entry : entries) {
+		entry = Entry();
+	}
+}
+
+OSCErrorLog::Entry * OSCErrorLog::find(uint32_t hash, std::string_view kind, std::string_view address) {
+	for (std::size_t i = 0; i < size; i++) {
+		Entry & entry = entries[(head + i) % CAPACITY];
+		if (entry.hash == hash
+			&& address.substr(0, ADDRESS_LENGTH - 1) == entry.address
+			&& kind.substr(0, KIND_LENGTH - 1) == entry.kind) {
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+OSCErrorLog::Entry & OSCErrorLog::insert(uint32_t hash, std::string_view kind, std::string_view address, double now) {
+	std::size_t slot;
+	if (size < CAPACITY) {
+		slot = (head + size) % CAPACITY;
+		size++;
+	} else {
+		slot = head; // recycle the oldest key
+		head = (head + 1) % CAPACITY;
+		if (entries[slot].pending > 0) stats.evicted++;
+	}
+
+	Entry & entry = entries[slot];
+	entry = Entry();
+	entry.hash = hash;
+	entry.firstSeen = now;
+	copyTruncated(entry.address, address);
+	copyTruncated(entry.kind, kind);
+	return entry;
+}
+
+// FNV-1a over the (truncated) key, so lookups match what was stored
+uint32_t OSCErrorLog::hashKey(std::string_view kind, std::string_view address) {
+	uint32_t hash = 2166136261u;
+	auto mix = [&hash](std::string_view text) {
+		for (char c : text) {
+			hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+		}
+		hash = (hash ^ 0xffu) * 16777619u;
+	};
+	mix(kind.substr(0, KIND_LENGTH - 1));
+	mix(address.substr(0, ADDRESS_LENGTH - 1));
+	return hash;
+}
+
+template <std::size_t N>
+void OSCErrorLog::copyTruncated(char (&dest)[N], std::string_view text) {
+	std::size_t length = std::min(text.size(), N - 1);
+	std::memcpy(dest, text.data(), length);
+	dest[length] = '\0';
+}
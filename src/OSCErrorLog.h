@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+
+// Fixed-size ring of OSC error reports, keyed by (address, kind).
+// The first report of a key is logged at once (up to FIRST_LOG_BUDGET new keys
+// per interval); repeats are only counted and summarised once per interval by
+// update(). Entries are plain char buffers, so reporting never allocates and a
+// sender spamming a bad address costs a table lookup, not a console write.
+// When the ring is full the oldest key is recycled.
+// Locked internally: the egress I/O thread reports send failures while the
+// frame thread reports, summarises and queries.
+class OSCErrorLog {
+public:
+	static constexpr std::size_t CAPACITY = 64;
+	static constexpr std::size_t FIRST_LOG_BUDGET = 10;
+	static constexpr std::size_t ADDRESS_LENGTH = 64;
+	static constexpr std::size_t KIND_LENGTH = 32;
+	static constexpr std::size_t MESSAGE_LENGTH = 128;
+
+	struct Entry {
+		char address[ADDRESS_LENGTH] = {};
+		char kind[KIND_LENGTH] = {};
+		char message[MESSAGE_LENGTH] = {}; // latest
+		uint32_t hash = 0;
+		uint64_t count = 0; // total since the key was first seen
+		uint64_t pending = 0; // not yet logged or summarised
+		double firstSeen = 0.0;
+		double lastSeen = 0.0;
+	};
+
+	struct Stats {
+		uint64_t reported = 0;
+		uint64_t logged = 0; // written immediately (first occurrences)
+		uint64_t summaries = 0; // summary lines written
+		uint64_t evicted = 0; // keys recycled while still pending
+	};
+
+	// kind is the reporting context ("led_rgb", "getArgument", ...); times in seconds
+	void report(std::string_view kind, std::string_view address, std::string_view message, double now);
+
+	// Write one summary line per key with pending repeats, every interval seconds
+	void update(double now);
+	void setSummaryInterval(float seconds) { summaryInterval = seconds; }
+	float getSummaryInterval() const { return summaryInterval; }
+
+	// Entries oldest first, from a copy taken under the lock (fn may report)
+	template <typename Fn>
+	void forEach(Fn && fn) const {
+		std::array<Entry, CAPACITY> snapshot;
+		std::size_t count;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			count = size;
+			for (std::size_t i = 0; i < count; i++) {
+				snapshot[i] = entries[(head + i) % CAPACITY];
+			}
+		}
+		for (std::size_t i = 0; i < count; i++) {
+			fn(snapshot[i]);
+		}
+	}
+	std::size_t getSize() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return size;
+	}
+	Stats getStats() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return stats;
+	}
+	void clear();
+
+private:
+	mutable std::mutex mutex;
+	std::array<Entry, CAPACITY> entries;
+	std::size_t head = 0; // oldest entry
+	std::size_t size = 0;
+	Stats stats;
+
+	float summaryInterval = 5.0f;
+	double lastSummary = 0.0;
+	std::size_t firstLogsThisInterval = 0;
+
+	Entry * find(uint32_t hash, std::string_view kind, std::string_view address);
+	Entry & insert(uint32_t hash, std::string_view kind, std::string_view address, double now);
+	static uint32_t hashKey(std::string_view kind, std::string_view address);
+	template <std::size_t N>
+	static void copyTruncated(char (&dest)[N], std::string_view text);
+};
@@ -1,8 +1,9 @@
 #include "OSCHelper.h"
+#include "OscOutboundPacketStream.h"
 
 // Parameter validation (logs error internally if invalid)
-bool OSCHelper::validateParameters(const ofxOscMessage & msg, int expectedCount, const std::string & commandContext) {
-	if (msg.getNumArgs() < expectedCount) {
+bool OSCHelper::validateParameters(const OSCMessageView & msg, int expectedCount, const std::string & commandContext) {
+	if ((int)msg.getNumArgs() < expectedCount) {
 		logError(commandContext, msg.getAddress(),
 			"Insufficient parameters (expected " + ofToString(expectedCount) + ", got " + ofToString(msg.getNumArgs()) + ")");
 		return false;
@@ -10,12 +11,94 @@ bool OSCHelper::validateParameters(const ofxOscMessage & msg, int expectedCount,
 	return true;
 }
 
+void OSCHelper::encodeMessage(const ofxOscMessage & in, osc::OutboundPacketStream & out) {
+	out << osc::BeginMessage(in.getAddress().c_str());
+
+	for (size_t i = 0; i < in.getNumArgs(); i++) {
+		switch (in.getArgType(i)) {
+		case OFXOSC_TYPE_INT32:
+			out << in.getArgAsInt32(i);
+			break;
+		case OFXOSC_TYPE_INT64:
+			out << (osc::int64)in.getArgAsInt64(i);
+			break;
+		case OFXOSC_TYPE_FLOAT:
+			out << in.getArgAsFloat(i);
+			break;
+		case OFXOSC_TYPE_DOUBLE:
+			out << in.getArgAsDouble(i);
+			break;
+		case OFXOSC_TYPE_STRING:
+			out << in.getArgAsString(i).c_str();
+			break;
+		case OFXOSC_TYPE_SYMBOL:
+			out << osc::Symbol(in.getArgAsSymbol(i).c_str());
+			break;
+		case OFXOSC_TYPE_CHAR:
+			out << in.getArgAsChar(i);
+			break;
+		case OFXOSC_TYPE_MIDI_MESSAGE:
+			out << osc::MidiMessage(in.getArgAsMidiMessage(i));
+			break;
+		case OFXOSC_TYPE_TRUE:
+		case OFXOSC_TYPE_FALSE:
+			out << in.getArgAsBool(i);
+			break;
+		case OFXOSC_TYPE_TRIGGER:
+			out << osc::Infinitum;
+			break;
+		case OFXOSC_TYPE_TIMETAG:
+			out << osc::TimeTag(in.getArgAsTimetag(i));
+			break;
+		case OFXOSC_TYPE_RGBA_COLOR:
+			out << osc::RgbaColor(in.getArgAsRgbaColor(i));
+			break;
+		case OFXOSC_TYPE_BLOB: {
+			ofBuffer blob = in.getArgAsBlob(i);
+			out << osc::Blob(blob.getData(), (osc::osc_bundle_element_size_t)blob.size());
+			break;
+		}
+		case OFXOSC_TYPE_NONE:
+			out << osc::OscNil;
+			break;
+		default:
+			logError("encodeMessage", in.getAddress(), "Unsupported argument type '" + std::string(1, in.getArgTypeName(i)) + "'");
+			break;
+		}
+	}
+
+	out << osc::EndMessage;
+}
+
+OSCErrorLog * OSCHelper::errorLog = nullptr;
+std::shared_mutex OSCHelper::errorLogMutex;
+
+void OSCHelper::setErrorLog(OSCErrorLog * log) {
+	std::unique_lock<std::shared_mutex> lock(errorLogMutex);
+	errorLog = log;
+}
+
+void OSCHelper::clearErrorLog(const OSCErrorLog * log) {
+	std::unique_lock<std::shared_mutex> lock(errorLogMutex);
+	if (errorLog == log) errorLog = nullptr;
+}
+
 // General OSC error logging
 void OSCHelper::logError(const std::string & context, const std::string & errorMessage) {
+	std::shared_lock<std::shared_mutex> lock(errorLogMutex);
+	if (errorLog) {
+		errorLog->report(context, "", errorMessage, ofGetElapsedTimef());
+		return;
+	}
 	ofLogError("OSCHelper::" + context) << errorMessage;
 }
 
-void OSCHelper::logError(const std::string & context, const std::string & originalAddress, const std::string & errorMessage) {
+void OSCHelper::logError(const std::string & context, std::string_view originalAddress, const std::string & errorMessage) {
+	std::shared_lock<std::shared_mutex> lock(errorLogMutex);
+	if (errorLog) {
+		errorLog->report(context, originalAddress, errorMessage, ofGetElapsedTimef());
+		return;
+	}
 	ofLogError("OSCHelper::" + context) << "[" << originalAddress << "]: " << errorMessage;
 }
 
@@ -46,7 +129,7 @@ bool OSCHelper::isValidPWMValue(int value) {
 }
 
 // Explicit instantiations for getArgument if needed, or keep in header if simple enough
-// template std::string OSCHelper::getArgument<std::string>(const ofxOscMessage& msg, int index, std::string defaultValue);
-// template int OSCHelper::getArgument<int>(const ofxOscMessage& msg, int index, int defaultValue);
-// template float OSCHelper::getArgument<float>(const ofxOscMessage& msg, int index, float defaultValue);
-// template bool OSCHelper::getArgument<bool>(const ofxOscMessage& msg, int index, bool defaultValue);
\ No newline at end of file
+// template std::string_view OSCHelper::getArgument<std::string_view>(const OSCMessageView& msg, int index, std::string_view defaultValue);
+// template int OSCHelper::getArgument<int>(const OSCMessageView& msg, int index, int defaultValue);
+// template float OSCHelper::getArgument<float>(const OSCMessageView& msg, int index, float defaultValue);
+// template bool OSCHelper::getArgument<bool>(const OSCMessageView& msg, int index, bool defaultValue);
\ No newline at end of file
@@ -1,46 +1,68 @@
 #pragma once
 
+#include "OSCErrorLog.h"
+#include "OSCMessageView.h"
 #include "ofMain.h"
 #include "ofxOsc.h"
 #include <algorithm> // For std::clamp, std::min, std::max
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Forward declaration
 class OSCController; // For access to sendError, if needed, though trying to make OSCHelper standalone
+namespace osc {
+class OutboundPacketStream;
+}
 
 class OSCHelper {
 public:
 	// Parameter validation (logs error internally if invalid)
-	static bool validateParameters(const ofxOscMessage & msg, int expectedCount, const std::string & commandContext);
+	static bool validateParameters(const OSCMessageView & msg, int expectedCount, const std::string & commandContext);
 
-	// General OSC error logging
+	// Encode an ofxOscMessage into an oscpack stream (same mapping as ofxOscSender),
+	// so messages built in code go through the same view-based handlers
+	static void encodeMessage(const ofxOscMessage & in, osc::OutboundPacketStream & out);
+
+	// General OSC error logging (aggregated by the error log when one is set,
+	// written straight to ofLog otherwise). Called from the frame and egress
+	// I/O threads: setErrorLog() waits for reports in progress, so once a log
+	// is detached nothing reports into it.
 	static void logError(const std::string & context, const std::string & errorMessage);
-	static void logError(const std::string & context, const std::string & originalAddress, const std::string & errorMessage);
+	static void logError(const std::string & context, std::string_view originalAddress, const std::string & errorMessage);
+	static void setErrorLog(OSCErrorLog * log);
+	// Detaches log if it is the current one
+	static void clearErrorLog(const OSCErrorLog * log);
 
-	// Argument extraction
+	// Argument extraction, reading straight from the packet (strings come back as
+	// std::string_view into it)
 	template <typename T>
-	static T getArgument(const ofxOscMessage & msg, int index, T defaultValue = T {}) {
-		if (index >= msg.getNumArgs()) return defaultValue;
+	static T getArgument(const OSCMessageView & msg, int index, T defaultValue = T {}) {
+		if (index >= (int)msg.getNumArgs()) return defaultValue;
+		char type = msg.getArgType(index);
 
 		if constexpr (std::is_same_v<T, int>) {
-			if (msg.getArgType(index) == OFXOSC_TYPE_INT32 || msg.getArgType(index) == OFXOSC_TYPE_INT64) return msg.getArgAsInt(index);
-			if (msg.getArgType(index) == OFXOSC_TYPE_FLOAT) return static_cast<T>(msg.getArgAsFloat(index)); // Allow float to int conversion
+			if (type == OFXOSC_TYPE_INT32) return msg.getInt32(index);
+			if (type == OFXOSC_TYPE_INT64) return static_cast<T>(msg.getInt64(index));
+			if (type == OFXOSC_TYPE_FLOAT) return static_cast<T>(msg.getFloat(index)); // Allow float to int conversion
 			logError("getArgument", msg.getAddress(), "Type mismatch for int argument at index " + ofToString(index));
 			return defaultValue;
 		} else if constexpr (std::is_same_v<T, float>) {
-			if (msg.getArgType(index) == OFXOSC_TYPE_FLOAT) return msg.getArgAsFloat(index);
-			if (msg.getArgType(index) == OFXOSC_TYPE_INT32 || msg.getArgType(index) == OFXOSC_TYPE_INT64) return static_cast<T>(msg.getArgAsInt(index)); // Allow int to float
+			if (type == OFXOSC_TYPE_FLOAT) return msg.getFloat(index);
+			if (type == OFXOSC_TYPE_INT32) return static_cast<T>(msg.getInt32(index)); // Allow int to float
+			if (type == OFXOSC_TYPE_INT64) return static_cast<T>(msg.getInt64(index));
 			logError("getArgument", msg.getAddress(), "Type mismatch for float argument at index " + ofToString(index));
 			return defaultValue;
 		} else if constexpr (std::is_same_v<T, bool>) {
-			if (msg.getArgType(index) == OFXOSC_TYPE_TRUE) return true;
-			if (msg.getArgType(index) == OFXOSC_TYPE_FALSE) return false;
-			if (msg.getArgType(index) == OFXOSC_TYPE_INT32 || msg.getArgType(index) == OFXOSC_TYPE_INT64) return msg.getArgAsInt(index) != 0; // Allow int to bool
+			if (type == OFXOSC_TYPE_TRUE) return true;
+			if (type == OFXOSC_TYPE_FALSE) return false;
+			if (type == OFXOSC_TYPE_INT32) return msg.getInt32(index) != 0; // Allow int to bool
+			if (type == OFXOSC_TYPE_INT64) return msg.getInt64(index) != 0;
 			logError("getArgument", msg.getAddress(), "Type mismatch for bool argument at index " + ofToString(index));
 			return defaultValue;
-		} else if constexpr (std::is_same_v<T, std::string>) {
-			if (msg.getArgType(index) == OFXOSC_TYPE_STRING) return msg.getArgAsString(index);
+		} else if constexpr (std::is_same_v<T, std::string_view>) {
+			if (type == OFXOSC_TYPE_STRING) return msg.getString(index);
 			logError("getArgument", msg.getAddress(), "Type mismatch for string argument at index " + ofToString(index));
 			return defaultValue;
 		}
@@ -56,4 +78,8 @@ public:
 	static bool isValidMicrostep(int microstep);
 	static bool isValidAngle(float angle);
 	static bool isValidPWMValue(int value);
+
+private:
+	static OSCErrorLog * errorLog; // guarded by errorLogMutex
+	static std::shared_mutex errorLogMutex;
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// One OSC message serialised up front: address, type tags and zeroed argument
+// slots are laid out once, and setInt32()/setFloat() then patch the argument
+// bytes in place. Sending the same address every tick needs no string
+// formatting, no ofxOscMessage and no heap allocation.
+//
+// Only 'i' and 'f' arguments are supported (fixed 4-byte slots); the whole
+// message must fit in MAX_SIZE bytes. Check isValid() after construction.
+class OSCMessageTemplate {
+public:
+	static constexpr std::size_t MAX_SIZE = 96;
+	static constexpr std::size_t MAX_ARGS = 8;
+
+	OSCMessageTemplate() = default;
+
+	OSCMessageTemplate(std::string_view address, std::string_view typeTags) {
+		std::size_t addressSize = padded(address.size());
+		std::size_t tagsSize = padded(1 + typeTags.size());
+		std::size_t total = addressSize + tagsSize + 4 * typeTags.size();
+		if (address.empty() || address[0] != '/' || typeTags.size() > MAX_ARGS || total > MAX_SIZE) return;
+		for (char tag : typeTags) {
+			if (tag != 'i' && tag != 'f') return;
+		}
+
+		bytes.fill(0);
+		std::memcpy(bytes.data(), address.data(), address.size());
+		bytes[addressSize] = ',';
+		std::memcpy(bytes.data() + addressSize + 1, typeTags.data(), typeTags.size());
+		std::size_t offset = addressSize + tagsSize;
+		for (std::size_t i = 0; i < typeTags.size(); i++) {
+			argOffsets[i] = static_cast<uint8_t>(offset);
+			offset += 4;
+		}
+		numArgs = typeTags.size();
+		size = total;
+	}
+
+	bool isValid() const { return size > 0; }
+	const char * data() const { return bytes.data(); }
+	std::size_t getSize() const { return size; }
+	std::size_t getNumArgs() const { return numArgs; }
+	std::string_view getAddress() const { return std::string_view(bytes.data()); }
+
+	// Index must be in range and match the tag given at construction
+	void setInt32(std::size_t index, int32_t value) { writeBigEndian(index, static_cast<uint32_t>(value)); }
+	void setFloat(std::size_t index, float value) {
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		writeBigEndian(index, bits);
+	}
+
+private:
+	std::array<char, MAX_SIZE> bytes {};
+	std::array<uint8_t, MAX_ARGS> argOffsets {};
+	std::size_t numArgs = 0;
+	std::size_t size = 0;
+
+	// OSC strings carry at least one terminating zero and are padded to 4 bytes
+	static std::size_t padded(std::size_t length) { return (length + 4) & ~std::size_t(3); }
+
+	void writeBigEndian(std::size_t index, uint32_t value) {
+		char * p = bytes.data() + argOffsets[index];
+		p[0] = static_cast<char>(value >> 24);
+		p[1] = static_cast<char>(value >> 16);
+		p[2] = static_cast<char>(value >> 8);
+		p[3] = static_cast<char>(value);
+	}
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// Non-owning, index-based view of one encoded OSC message. parse() validates
+// the packet once and records where each argument starts; the typed getters
+// then read straight from the packet bytes, and strings and blobs come back as
+// string_views into it. Nothing is copied or allocated, so the packet buffer
+// must outlive the view.
+//
+// Getters assume the index is in range and the tag matches (check with
+// getArgType() first) - OSCHelper::getArgument() does both.
+class OSCMessageView {
+public:
+	static constexpr std::size_t MAX_ARGS = 32;
+
+	OSCMessageView() = default;
+
+	// Returns false for anything oscpack's ReceivedMessage would reject, and
+	// for messages with more than MAX_ARGS arguments or array tags
+	bool parse(const char * data, std::size_t size) {
+		count = 0;
+		std::size_t pos = 0;
+		std::size_t addressLength = 0;
+		if (!readString(data, size, pos, addressLength) || addressLength == 0 || data[0] != '/') return false;
+		address = std::string_view(data, addressLength);
+		tags = std::string_view();
+		packet = data;
+
+		// A missing type tag string means no arguments (old OSC senders)
+		if (pos == size) return true;
+		if (data[pos] != ',') return false;
+		std::size_t tagsLength = 0;
+		std::size_t tagsStart = pos + 1;
+		if (!readString(data, size, pos, tagsLength)) return false;
+		tags = std::string_view(data + tagsStart, tagsLength - 1);
+		if (tags.size() > MAX_ARGS) return false;
+
+		for (char tag : tags) {
+			offsets[count++] = static_cast<uint32_t>(pos);
+			std::size_t length = 0;
+			switch (tag) {
+			case 'i':
+			case 'f':
+			case 'c':
+			case 'r':
+			case 'm':
+				if (size - pos < 4) return false;
+				pos += 4;
+				break;
+			case 'h':
+			case 'd':
+			case 't':
+				if (size - pos < 8) return false;
+				pos += 8;
+				break;
+			case 's':
+			case 'S':
+				if (!readString(data, size, pos, length)) return false;
+				break;
+			case 'b': {
+				if (size - pos < 4) return false;
+				int32_t blobSize = static_cast<int32_t>(readUInt32(data + pos));
+				if (blobSize < 0 || static_cast<std::size_t>(blobSize) > size - pos - 4) return false;
+				pos += 4 + padded(static_cast<std::size_t>(blobSize));
+				if (pos > size) return false;
+				break;
+			}
+			case 'T':
+			case 'F':
+			case 'N':
+			case 'I':
+				break;
+			default:
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::string_view getAddress() const { return address; }
+	std::string_view getTypeTags() const { return tags; }
+	std::size_t getNumArgs() const { return count; }
+
+	// OSC type tag character ('i', 'f', 's', ...), or 0 past the last argument
+	char getArgType(std::size_t index) const { return index < count ? tags[index] : 0; }
+	bool isNumber(std::size_t index) const {
+		char tag = getArgType(index);
+		return tag == 'i' || tag == 'f' || tag == 'h' || tag == 'd';
+	}
+
+	int32_t getInt32(std::size_t index) const { return static_cast<int32_t>(readUInt32(arg(index))); }
+	int64_t getInt64(std::size_t index) const { return static_cast<int64_t>(readUInt64(arg(index))); }
+	float getFloat(std::size_t index) const { return bitCast<float>(readUInt32(arg(index))); }
+	double getDouble(std::size_t index) const { return bitCast<double>(readUInt64(arg(index))); }
+	uint32_t getRgbaColor(std::size_t index) const { return readUInt32(arg(index)); }
+	bool getBool(std::size_t index) const { return tags[index] == 'T'; }
+
+	// Strings and symbols, without the terminating zero
+	std::string_view getString(std::size_t index) const { return std::string_view(arg(index)); }
+	std::string_view getBlob(std::size_t index) const {
+		return std::string_view(arg(index) + 4, readUInt32(arg(index)));
+	}
+
+private:
+	const char * packet = nullptr;
+	std::string_view address;
+	std::string_view tags;
+	std::array<uint32_t, MAX_ARGS> offsets {};
+	std::size_t count = 0;
+
+	const char * arg(std::size_t index) const { return packet + offsets[index]; }
+
+	static std::size_t padded(std::size_t length) { return (length + 3) & ~std::size_t(3); }
+
+	// Zero-terminated, zero-padded string at pos; advances pos past the padding
+	static bool readString(const char * data, std::size_t size, std::size_t & pos, std::size_t & length) {
+		if (pos >= size) return false;
+		const void * end = std::memchr(data + pos, '\0', size - pos);
+		if (!end) return false;
+		length = static_cast<const char *>(end) - (data + pos);
+		std::size_t next = pos + padded(length + 1);
+		if (next > size) return false;
+		pos = next;
+		return true;
+	}
+
+	static uint32_t readUInt32(const char * p) {
+		const unsigned char * u = reinterpret_cast<const unsigned char *>(p);
+		return (uint32_t(u[0]) << 24) | (uint32_t(u[1]) << 16) | (uint32_t(u[2]) << 8) | uint32_t(u[3]);
+	}
+	static uint64_t readUInt64(const char * p) {
+		return (uint64_t(readUInt32(p)) << 32) | readUInt32(p + 4);
+	}
+
+	template <typename To, typename From>
+	static To bitCast(From from) {
+		static_assert(sizeof(To) == sizeof(From), "size mismatch");
+		To to;
+		std::memcpy(&to, &from, sizeof(to));
+		return to;
+	}
+};
@@ -1,71 +1,80 @@
 #include "OSCOutController.h"
 #include "ofMain.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+// "#bundle\0" + immediate timetag, as ofxOscSender writes it
+constexpr char BUNDLE_HEADER[16] = { '#', 'b', 'u', 'n', 'd', 'l', 'e', 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+
+uint32_t readBigEndian(const char * p) {
+	const unsigned char * bytes = reinterpret_cast<const unsigned char *>(p);
+	return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+}
+
+void writeBigEndian(char * p, uint32_t value) {
+	p[0] = static_cast<char>(value >> 24);
+	p[1] = static_cast<char>(value >> 16);
+	p[2] = static_cast<char>(value >> 8);
+	p[3] = static_cast<char>(value);
+}
+
+}
 
 OSCOutController::OSCOutController()
 	: enabled(true)
-	, sentMessageCount(0) {
-	repeatThreadRunning = true;
-	repeatThread = std::thread(&OSCOutController::repeatWorker, this);
+	, sentMessageCount(0)
+	, sentPacketCount(0) {
 }
 
 OSCOutController::~OSCOutController() {
-	{
-		std::lock_guard<std::mutex> lock(repeatMutex);
-		repeatThreadRunning = false;
-	}
-	repeatCv.notify_all();
-	if (repeatThread.joinable()) {
-		repeatThread.join();
-	}
-	senders.clear();
+	releaseEndpoints();
 }
 
 void OSCOutController::sendMessageToAllRepeated(const ofxOscMessage & message, int totalSends) {
 	sendMessageToAll(message); // first send goes out immediately
 	if (totalSends <= 1) return;
 
-	{
-		std::lock_guard<std::mutex> lock(repeatMutex);
-		PendingRepeat pending;
-		pending.message = message;
-		pending.remaining = totalSends - 1;
-		pending.nextDue = std::chrono::steady_clock::now() + std::chrono::milliseconds(MOTOR_REPEAT_DELAY_MS);
-		repeatQueue.push_back(std::move(pending));
+	for (const auto & dest : destinations) {
+		if (!dest.enabled) continue;
+		auto it = endpoints.find(dest.name);
+		if (it != endpoints.end()) {
+			OSCEgressService::instance().scheduleRepeats(it->second, message, totalSends - 1, MOTOR_REPEAT_DELAY_MS);
+		}
 	}
-	repeatCv.notify_all();
 }
 
-void OSCOutController::repeatWorker() {
-	std::unique_lock<std::mutex> lock(repeatMutex);
-	while (repeatThreadRunning) {
-		if (repeatQueue.empty()) {
-			repeatCv.wait(lock, [this] { return !repeatThreadRunning || !repeatQueue.empty(); });
-			continue;
-		}
+void OSCOutController::sendMotorMessage(const ofxOscMessage & message) {
+	if (!motorTargets.empty()) {
+		ofxOscMessage addressed(message);
+		addressed.setAddress("/" + motorTargets + message.getAddress());
+		sendMessageToAllRepeated(addressed, MOTOR_SEND_REPEATS);
+		return;
+	}
+	if (!motorAckEnabled) {
+		sendMessageToAllRepeated(message, MOTOR_SEND_REPEATS);
+		return;
+	}
 
-		auto earliest = repeatQueue.front().nextDue;
-		for (const auto & pending : repeatQueue) {
-			earliest = std::min(earliest, pending.nextDue);
-		}
-		auto now = std::chrono::steady_clock::now();
-		if (earliest > now) {
-			repeatCv.wait_until(lock, earliest);
-			continue; // re-evaluate: new entries or shutdown may have arrived
+	for (const auto & dest : destinations) {
+		if (!dest.enabled) continue;
+		auto it = endpoints.find(dest.name);
+		if (it != endpoints.end()) {
+			OSCEgressService::instance().sendAcknowledged(it->second, message);
+			sentPacketCount++;
 		}
+	}
+	sentMessageCount++;
+}
 
-		for (auto it = repeatQueue.begin(); it != repeatQueue.end();) {
-			if (it->nextDue <= now) {
-				// destinations/senders are only mutated at configuration time,
-				// so sending from this thread is safe during playback
-				sendMessageToAll(it->message);
-				if (--it->remaining <= 0) {
-					it = repeatQueue.erase(it);
-					continue;
-				}
-				it->nextDue = now + std::chrono::milliseconds(MOTOR_REPEAT_DELAY_MS);
-			}
-			++it;
-		}
+void OSCOutController::setMotorAck(bool enable, int replyPort) {
+	motorAckReplyPort = replyPort;
+	motorAckConfigured = enable;
+	motorAckEnabled = enable;
+	if (enable && !OSCEgressService::instance().startAckListener(replyPort)) {
+		ofLogError("OSCOutController") << "Motor acks unavailable on port " << replyPort << " - using repeated sends";
+		motorAckEnabled = false;
 	}
 }
 
@@ -85,6 +94,8 @@ void OSCOutController::loadConfigurationFromJson(const ofJson & json) {
 			loadDestinationsFromJson(json["destinations"]);
 		}
 
+		loadMotorAckFromJson(json);
+
 	} catch (const std::exception & e) {
 		ofLogError("OSCOutController") << "Failed to load config from JSON: " << e.what();
 		// Fall back to default config
@@ -117,6 +128,8 @@ void OSCOutController::loadConfiguration(const std::string & configPath) {
 			loadDestinationsFromJson(json["destinations"]);
 		}
 
+		loadMotorAckFromJson(json);
+
 	} catch (const std::exception & e) {
 		ofLogError("OSCOutController") << "Failed to load config: " << e.what();
 		// Fall back to default config
@@ -129,6 +142,7 @@ void OSCOutController::saveConfiguration(const std::string & configPath) {
 		ofJson json;
 		json["enabled"] = enabled;
 		json["destinations"] = destinationsToJson();
+		json["motorAck"] = { { "enabled", motorAckConfigured }, { "replyPort", motorAckReplyPort } };
 
 		ofSaveJson(configPath, json);
 
@@ -157,7 +171,8 @@ void OSCOutController::removeDestination(const std::string & name) {
 
 	if (it != destinations.end()) {
 		destinations.erase(it, destinations.end());
-		senders.erase(name);
+		dropHeld(name);
+		releaseEndpoint(name);
 	}
 }
 
@@ -171,10 +186,39 @@ void OSCOutController::setDestinationEnabled(const std::string & name, bool enab
 	}
 }
 
+void OSCOutController::setDestinationRateLimit(const std::string & name, int maxPacketsPerSecond, int maxBytesPerSecond) {
+	for (auto & dest : destinations) {
+		if (dest.name == name) {
+			dest.maxPacketsPerSecond = std::max(0, maxPacketsPerSecond);
+			dest.maxBytesPerSecond = std::max(0, maxBytesPerSecond);
+			ensureSenderExists(dest);
+			break;
+		}
+	}
+}
+
 std::vector<OSCDestination> OSCOutController::getDestinations() const {
 	return destinations;
 }
 
+bool OSCOutController::hasEnabledDestination() const {
+	for (const auto & dest : destinations) {
+		if (dest.enabled && endpoints.count(dest.name)) return true;
+	}
+	return false;
+}
+
+std::string OSCOutController::destinationTypeToString(OSCDestinationType type) {
+	switch (type) {
+	case OSCDestinationType::Multicast:
+		return "multicast";
+	case OSCDestinationType::Broadcast:
+		return "broadcast";
+	default:
+		return "unicast";
+	}
+}
+
 // Motor control messages
 void OSCOutController::sendMotorZero(int deviceId) {
 	if (!enabled) return;
@@ -182,7 +226,7 @@ void OSCOutController::sendMotorZero(int deviceId) {
 	ofxOscMessage msg;
 	msg.setAddress("/motor/zero");
 
-	sendMessageToAllRepeated(msg, MOTOR_SEND_REPEATS);
+	sendMotorMessage(msg);
 }
 
 void OSCOutController::sendMotorHoming(int deviceId) {
@@ -191,7 +235,7 @@ void OSCOutController::sendMotorHoming(int deviceId) {
 	ofxOscMessage msg;
 	msg.setAddress("/motor/homing");
 
-	sendMessageToAllRepeated(msg, MOTOR_SEND_REPEATS);
+	sendMotorMessage(msg);
 }
 
 void OSCOutController::sendMotorEmergency(int deviceId) {
@@ -200,7 +244,7 @@ void OSCOutController::sendMotorEmergency(int deviceId) {
 	ofxOscMessage msg;
 	msg.setAddress("/motor/emergency");
 
-	sendMessageToAllRepeated(msg, MOTOR_SEND_REPEATS);
+	sendMotorMessage(msg);
 }
 
 void OSCOutController::sendMotorUstep(int deviceId, int ustepValue) {
@@ -213,7 +257,7 @@ void OSCOutController::sendMotorUstep(int deviceId, int ustepValue) {
 	msg.setAddress("/motor/ustep");
 	msg.addInt32Arg(ustepValue);
 
-	sendMessageToAllRepeated(msg, MOTOR_SEND_REPEATS);
+	sendMotorMessage(msg);
 }
 
 void OSCOutController::sendMotorRelative(int deviceId, float speedRotMin, float accDegPerS2, float moveDeg) {
@@ -225,7 +269,7 @@ void OSCOutController::sendMotorRelative(int deviceId, float speedRotMin, float
 	msg.addFloatArg(accDegPerS2);
 	msg.addFloatArg(moveDeg);
 
-	sendMessageToAllRepeated(msg, MOTOR_SEND_REPEATS);
+	sendMotorMessage(msg);
 }
 
 void OSCOutController::sendMotorRelativeStop(int deviceId, float accDegPerS2) {
@@ -235,7 +279,7 @@ void OSCOutController::sendMotorRelativeStop(int deviceId, float accDegPerS2) {
 	msg.setAddress("/motor/relative/stop");
 	msg.addFloatArg(accDegPerS2);
 
-	sendMessageToAllRepeated(msg, MOTOR_SEND_REPEATS);
+	sendMotorMessage(msg);
 }
 
 void OSCOutController::sendMotorAbsolute(int deviceId, float speedRotMin, float accDegPerS2, float moveDeg) {
@@ -247,7 +291,7 @@ void OSCOutController::sendMotorAbsolute(int deviceId, float speedRotMin, float
 	msg.addFloatArg(accDegPerS2);
 	msg.addFloatArg(moveDeg);
 
-	sendMessageToAllRepeated(msg, MOTOR_SEND_REPEATS);
+	sendMotorMessage(msg);
 }
 
 void OSCOutController::sendMotorAbsoluteStop(int deviceId, float accDegPerS2) {
@@ -257,29 +301,27 @@ void OSCOutController::sendMotorAbsoluteStop(int deviceId, float accDegPerS2) {
 	msg.setAddress("/motor/absolute/stop");
 	msg.addFloatArg(accDegPerS2);
 
-	sendMessageToAllRepeated(msg, MOTOR_SEND_REPEATS);
+	sendMotorMessage(msg);
 }
 
 // Electromagnet control messages
 void OSCOutController::sendMagnet(const std::string & position, int pwmValue) {
 	if (!enabled || !validatePWMValue(pwmValue)) return;
 
-	ofxOscMessage msg;
-	msg.setAddress("/mag/" + position);
-	msg.addInt32Arg(pwmValue);
+	OSCMessageTemplate & msg = templatesFor(position).magnet;
+	msg.setInt32(0, pwmValue);
 
-	sendMessageToAll(msg);
+	queueFrameMessage(msg);
 }
 
 // Power LED control messages
 void OSCOutController::sendPowerLED(const std::string & position, int pwmValue) {
 	if (!enabled || !validatePWMValue(pwmValue)) return;
 
-	ofxOscMessage msg;
-	msg.setAddress("/pwr/" + position);
-	msg.addInt32Arg(pwmValue);
+	OSCMessageTemplate & msg = templatesFor(position).power;
+	msg.setInt32(0, pwmValue);
 
-	sendMessageToAll(msg);
+	queueFrameMessage(msg);
 }
 
 // RGB LED circle control messages
@@ -289,13 +331,12 @@ void OSCOutController::sendRGBLED(const std::string & position, uint8_t red, uin
 
 	uint32_t rgba = encodeRGBA(red, green, blue, alpha);
 
-	ofxOscMessage msg;
-	msg.setAddress("/rgb/" + position);
-	msg.addInt32Arg(static_cast<int32_t>(rgba));
-	msg.addInt32Arg(originDeg);
-	msg.addInt32Arg(arcDeg);
+	OSCMessageTemplate & msg = templatesFor(position).rgb;
+	msg.setInt32(0, static_cast<int32_t>(rgba));
+	msg.setInt32(1, originDeg);
+	msg.setInt32(2, arcDeg);
 
-	sendMessageToAll(msg);
+	queueFrameMessage(msg);
 }
 
 void OSCOutController::sendRGBLED(const std::string & position, const ofColor & color, uint8_t alpha, int originDeg, int arcDeg) {
@@ -304,11 +345,28 @@ void OSCOutController::sendRGBLED(const std::string & position, const ofColor &
 
 // Internal helpers
 void OSCOutController::ensureSenderExists(const OSCDestination & dest) {
-	if (senders.find(dest.name) == senders.end()) {
-		auto sender = std::unique_ptr<ofxOscSender>(new ofxOscSender());
-		sender->setup(dest.ip, dest.port);
-		senders[dest.name] = std::move(sender);
+	auto it = endpoints.find(dest.name);
+	if (it == endpoints.end() || it->second->getHost() != dest.ip || it->second->getPort() != dest.port) {
+		releaseEndpoint(dest.name);
+		endpoints[dest.name] = OSCEgressService::instance().acquire(dest.ip, dest.port);
 	}
+	// The endpoint is the device: controllers sharing it share its budget,
+	// limited by the strictest of their settings
+	endpoints[dest.name]->setRateLimit(this, dest.name, dest.maxPacketsPerSecond, dest.maxBytesPerSecond);
+}
+
+void OSCOutController::releaseEndpoint(const std::string & destinationName) {
+	auto it = endpoints.find(destinationName);
+	if (it == endpoints.end()) return;
+	it->second->releaseRateLimit(this, destinationName);
+	endpoints.erase(it);
+}
+
+void OSCOutController::releaseEndpoints() {
+	for (auto & entry : endpoints) {
+		entry.second->releaseRateLimit(this, entry.first);
+	}
+	endpoints.clear();
 }
 
 void OSCOutController::sendMessageToAll(const ofxOscMessage & message) {
@@ -323,9 +381,180 @@ void OSCOutController::sendMessageToAll(const ofxOscMessage & message) {
 }
 
 void OSCOutController::sendMessageToDestination(const ofxOscMessage & message, const OSCDestination & dest) {
-	auto it = senders.find(dest.name);
-	if (it != senders.end()) {
+	auto it = endpoints.find(dest.name);
+	if (it != endpoints.end()) {
 		it->second->sendMessage(message);
+		sentPacketCount++;
+	}
+}
+
+size_t OSCOutController::getLedStateBytes(const std::string & position) {
+	const PositionTemplates & templates = templatesFor(position);
+	size_t perDestination = 12 + templates.rgb.getSize() + templates.power.getSize() + templates.magnet.getSize(); // 4-byte element sizes
+	size_t destinationCount = 0;
+	for (const auto & dest : destinations) {
+		if (dest.enabled && endpoints.count(dest.name)) destinationCount++;
+	}
+	return perDestination * destinationCount;
+}
+
+OSCOutController::PositionTemplates & OSCOutController::templatesFor(const std::string & position) {
+	auto it = positionTemplates.find(position);
+	if (it != positionTemplates.end()) return it->second;
+
+	// First use of this position: the only time its addresses are formatted
+	PositionTemplates templates;
+	templates.rgb = OSCMessageTemplate("/rgb/" + position, "iii");
+	templates.power = OSCMessageTemplate("/pwr/" + position, "i");
+	templates.magnet = OSCMessageTemplate("/mag/" + position, "i");
+	if (!templates.rgb.isValid()) {
+		ofLogError("OSCOutController") << "LED position name too long: " << position;
+	}
+	return positionTemplates.emplace(position, templates).first->second;
+}
+
+void OSCOutController::queueFrameMessage(const OSCMessageTemplate & message) {
+	if (!message.isValid()) return;
+	char sizeBytes[4];
+	writeBigEndian(sizeBytes, static_cast<uint32_t>(message.getSize()));
+	frameBytes.insert(frameBytes.end(), sizeBytes, sizeBytes + 4);
+	frameBytes.insert(frameBytes.end(), message.data(), message.data() + message.getSize());
+	frameMessageCount++;
+}
+
+void OSCOutController::flushFrame() {
+	if (!enabled) {
+		frameBytes.clear();
+		frameMessageCount = 0;
+		while (!heldMessages.empty()) {
+			dropHeld(heldMessages.begin()->first);
+		}
+		return;
+	}
+	if (frameMessageCount == 0 && getHeldMessageCount() == 0) return;
+
+	// Unlimited destinations get this frame's elements behind the bundle
+	// header, a new datagram whenever the next element would not fit
+	if (frameMessageCount > 0) {
+		char datagram[MAX_DATAGRAM_SIZE];
+		std::memcpy(datagram, BUNDLE_HEADER, sizeof(BUNDLE_HEADER));
+		size_t datagramSize = sizeof(BUNDLE_HEADER);
+		for (size_t pos = 0; pos < frameBytes.size();) {
+			size_t elementSize = 4 + readBigEndian(frameBytes.data() + pos);
+			if (datagramSize > sizeof(BUNDLE_HEADER) && datagramSize + elementSize > MAX_DATAGRAM_SIZE) {
+				sendPacketToUnlimited(datagram, datagramSize);
+				datagramSize = sizeof(BUNDLE_HEADER);
+			}
+			std::memcpy(datagram + datagramSize, frameBytes.data() + pos, elementSize);
+			datagramSize += elementSize;
+			pos += elementSize;
+		}
+		sendPacketToUnlimited(datagram, datagramSize);
+	}
+
+	// Rate-limited destinations coalesce into their held set and send what
+	// their budget allows; anything left waits for a later tick
+	double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	for (const auto & dest : destinations) {
+		if (!dest.enabled) continue;
+		auto it = endpoints.find(dest.name);
+		if (it == endpoints.end() || !it->second->isRateLimited()) continue;
+		std::vector<HeldMessage> & held = heldMessages[dest.name];
+		it->second->countCoalesced(holdFrame(held));
+		sendHeld(held, it->second, now);
+		if (!held.empty()) deferredSendCount++;
+	}
+
+	sentMessageCount += static_cast<int>(frameMessageCount);
+	frameBytes.clear();
+	frameMessageCount = 0;
+}
+
+size_t OSCOutController::holdFrame(std::vector<HeldMessage> & held) {
+	size_t coalesced = 0;
+	for (size_t pos = 0; pos < frameBytes.size();) {
+		size_t size = readBigEndian(frameBytes.data() + pos);
+		const char * message = frameBytes.data() + pos + 4;
+		pos += 4 + size;
+
+		std::string_view address(message);
+		auto it = std::find_if(held.begin(), held.end(), [address](const HeldMessage & m) { return m.getAddress() == address; });
+		if (it == held.end()) {
+			it = held.insert(held.end(), HeldMessage {});
+		} else {
+			coalesced++;
+		}
+		std::memcpy(it->bytes.data(), message, size);
+		it->size = size;
+	}
+	coalescedMessageCount += static_cast<int>(coalesced);
+	return coalesced;
+}
+
+// Held updates that will never be sent count as dropped on their endpoint
+void OSCOutController::dropHeld(const std::string & destinationName) {
+	auto held = heldMessages.find(destinationName);
+	if (held == heldMessages.end()) return;
+	auto endpoint = endpoints.find(destinationName);
+	if (endpoint != endpoints.end()) endpoint->second->countDropped(held->second.size());
+	heldMessages.erase(held);
+}
+
+void OSCOutController::sendHeld(std::vector<HeldMessage> & held, const std::shared_ptr<OSCEgressService::Endpoint> & endpoint, double now) {
+	char datagram[MAX_DATAGRAM_SIZE];
+	std::memcpy(datagram, BUNDLE_HEADER, sizeof(BUNDLE_HEADER));
+	size_t datagramSize = sizeof(BUNDLE_HEADER);
+	size_t sent = 0; // held[0, sent) have gone out
+	for (size_t i = 0; i <= held.size(); i++) {
+		bool full = i < held.size() && datagramSize + 4 + held[i].size > MAX_DATAGRAM_SIZE;
+		if ((i == held.size() || full) && datagramSize > sizeof(BUNDLE_HEADER)) {
+			if (!endpoint->tryConsume(datagramSize, now)) break;
+			OSCEgressService::instance().queuePacket(endpoint, datagram, datagramSize);
+			sentPacketCount++;
+			sent = i;
+			datagramSize = sizeof(BUNDLE_HEADER);
+		}
+		if (i == held.size()) break;
+		writeBigEndian(datagram + datagramSize, static_cast<uint32_t>(held[i].size));
+		std::memcpy(datagram + datagramSize + 4, held[i].bytes.data(), held[i].size);
+		datagramSize += 4 + held[i].size;
+	}
+	held.erase(held.begin(), held.begin() + sent);
+}
+
+std::vector<OSCOutController::DestinationStats> OSCOutController::getDestinationStats() const {
+	std::vector<DestinationStats> stats;
+	for (const auto & dest : destinations) {
+		DestinationStats entry;
+		entry.name = dest.name;
+		entry.ip = dest.ip;
+		entry.port = dest.port;
+		entry.enabled = dest.enabled;
+		auto held = heldMessages.find(dest.name);
+		if (held != heldMessages.end()) entry.held = held->second.size();
+		auto endpoint = endpoints.find(dest.name);
+		if (endpoint != endpoints.end()) entry.egress = endpoint->second->getStats();
+		stats.push_back(entry);
+	}
+	return stats;
+}
+
+size_t OSCOutController::getHeldMessageCount() const {
+	size_t count = 0;
+	for (const auto & entry : heldMessages) {
+		count += entry.second.size();
+	}
+	return count;
+}
+
+void OSCOutController::sendPacketToUnlimited(const char * data, size_t size) {
+	for (const auto & dest : destinations) {
+		if (!dest.enabled) continue;
+		auto it = endpoints.find(dest.name);
+		if (it != endpoints.end() && !it->second->isRateLimited()) {
+			OSCEgressService::instance().queuePacket(it->second, data, size);
+			sentPacketCount++;
+		}
 	}
 }
 
@@ -348,6 +577,8 @@ uint32_t OSCOutController::encodeRGBA(uint8_t red, uint8_t green, uint8_t blue,
 // JSON helpers
 void OSCOutController::loadDestinationsFromJson(const ofJson & json) {
 	destinations.clear();
+	releaseEndpoints();
+	heldMessages.clear();
 
 	for (const auto & destJson : json) {
 		if (destJson.contains("ip") && destJson.contains("port")) {
@@ -361,6 +592,21 @@ void OSCOutController::loadDestinationsFromJson(const ofJson & json) {
 			dest.ip = destJson["ip"];
 			dest.port = destJson["port"];
 			dest.enabled = destJson.value("enabled", true);
+			dest.maxPacketsPerSecond = std::max(0, destJson.value("maxPacketsPerSecond", 0));
+			dest.maxBytesPerSecond = std::max(0, destJson.value("maxBytesPerSecond", 0));
+
+			std::string type = destJson.value("type", std::string("unicast"));
+			if (type == "multicast") {
+				dest.type = OSCDestinationType::Multicast;
+				int firstOctet = ofToInt(dest.ip.substr(0, dest.ip.find('.')));
+				if (firstOctet < 224 || firstOctet > 239) {
+					ofLogWarning("OSCOutController") << "Destination " << dest.name << ": " << dest.ip << " is not a multicast group (224.0.0.0-239.255.255.255)";
+				}
+			} else if (type == "broadcast") {
+				dest.type = OSCDestinationType::Broadcast;
+			} else if (type != "unicast") {
+				ofLogWarning("OSCOutController") << "Destination " << dest.name << ": unknown type '" << type << "', using unicast";
+			}
 
 			destinations.push_back(dest);
 			ensureSenderExists(dest);
@@ -368,6 +614,16 @@ void OSCOutController::loadDestinationsFromJson(const ofJson & json) {
 	}
 }
 
+// "motorAck": { "enabled": true, "replyPort": 9100 }
+void OSCOutController::loadMotorAckFromJson(const ofJson & json) {
+	if (!json.contains("motorAck")) {
+		setMotorAck(false);
+		return;
+	}
+	const ofJson & ack = json["motorAck"];
+	setMotorAck(ack.value("enabled", false), ack.value("replyPort", DEFAULT_MOTOR_ACK_PORT));
+}
+
 ofJson OSCOutController::destinationsToJson() const {
 	ofJson json = ofJson::array();
 
@@ -377,6 +633,9 @@ ofJson OSCOutController::destinationsToJson() const {
 		destJson["ip"] = dest.ip;
 		destJson["port"] = dest.port;
 		destJson["enabled"] = dest.enabled;
+		if (dest.type != OSCDestinationType::Unicast) destJson["type"] = destinationTypeToString(dest.type);
+		if (dest.maxPacketsPerSecond > 0) destJson["maxPacketsPerSecond"] = dest.maxPacketsPerSecond;
+		if (dest.maxBytesPerSecond > 0) destJson["maxBytesPerSecond"] = dest.maxBytesPerSecond;
 		json.push_back(destJson);
 	}
 
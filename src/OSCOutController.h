@@ -1,24 +1,35 @@
 #pragma once
 
+#include "OSCEgressService.h"
+#include "OSCMessageTemplate.h"
 #include "ofMain.h"
 #include "ofxOsc.h"
+#include <array>
 #include <atomic>
-#include <chrono>
-#include <condition_variable>
-#include <deque>
 #include <map>
 #include <memory>
-#include <mutex>
 #include <string>
-#include <thread>
+#include <string_view>
 #include <vector>
 
+// Unicast reaches one device; multicast (224.0.0.0/4) and subnet broadcast
+// reach every device listening on the port ("type" in the JSON)
+enum class OSCDestinationType {
+	Unicast,
+	Multicast,
+	Broadcast
+};
+
 // OSC Destination configuration
 struct OSCDestination {
 	std::string name;
 	std::string ip;
 	int port;
 	bool enabled = true;
+	OSCDestinationType type = OSCDestinationType::Unicast;
+	// LED traffic pacing on this ip:port, 0 = unlimited (motor commands are exempt)
+	int maxPacketsPerSecond = 0;
+	int maxBytesPerSecond = 0;
 };
 
 class OSCOutController {
@@ -36,7 +47,17 @@ public:
 	void addDestination(const std::string & name, const std::string & ip, int port);
 	void removeDestination(const std::string & name);
 	void setDestinationEnabled(const std::string & name, bool enabled);
+	void setDestinationRateLimit(const std::string & name, int maxPacketsPerSecond, int maxBytesPerSecond);
 	std::vector<OSCDestination> getDestinations() const;
+	bool hasEnabledDestination() const;
+	ofJson destinationsToJson() const;
+	static std::string destinationTypeToString(OSCDestinationType type);
+
+	// Group (multicast/broadcast) controllers carry device addressing in the
+	// message: motor addresses are prefixed with the target motor ids, e.g.
+	// "/1-4,7/motor/relative". Empty (the default) sends plain "/motor/...".
+	void setMotorTargets(const std::string & targets) { motorTargets = targets; }
+	const std::string & getMotorTargets() const { return motorTargets; }
 
 	// Motor control messages
 	void sendMotorZero(int deviceId = -1);
@@ -63,41 +84,117 @@ public:
 	bool isEnabled() const { return enabled; }
 	void setEnabled(bool enable) { enabled = enable; }
 
+	// LED, power LED and magnet messages are queued during the tick and sent by
+	// flushFrame() as one bundle per destination (ofxOscSender already wrapped
+	// every message in its own bundle), split only where it would exceed
+	// MAX_DATAGRAM_SIZE. Motor commands are never queued. The datagrams join
+	// the tick's egress batch, which goes out on OSCEgressService::flushPackets().
+	// Rate-limited destinations instead keep the latest value per address and
+	// get them once their token buckets allow: updates coalesce, never queue.
+	void flushFrame();
+	size_t getQueuedMessageCount() const { return frameMessageCount; }
+
+	// Bytes one full LED/power/magnet state of a position adds to a frame,
+	// summed over enabled destinations
+	size_t getLedStateBytes(const std::string & position);
+	static constexpr size_t MAX_DATAGRAM_SIZE = OSCEgressService::MAX_DATAGRAM_SIZE;
+
 	// Get statistics
 	int getSentMessageCount() const { return sentMessageCount; }
-	void resetStats() { sentMessageCount = 0; }
+	int getSentPacketCount() const { return sentPacketCount; } // datagrams, all destinations
+	int getCoalescedMessageCount() const { return coalescedMessageCount; } // overwritten before a rate-limited send
+	int getDeferredSendCount() const { return deferredSendCount; } // ticks a rate-limited destination had to wait
+	size_t getHeldMessageCount() const;
+
+	// Per-destination egress counters (the endpoint's, so shared with any other
+	// controller on the same ip:port) plus this controller's held updates
+	struct DestinationStats {
+		std::string name;
+		std::string ip;
+		int port = 0;
+		bool enabled = true;
+		size_t held = 0;
+		OSCEgressService::Endpoint::Stats egress;
+	};
+	std::vector<DestinationStats> getDestinationStats() const;
+	void resetStats() {
+		sentMessageCount = 0;
+		sentPacketCount = 0;
+		coalescedMessageCount = 0;
+		deferredSendCount = 0;
+	}
 
 	// Motor commands are one-shot and critical: repeat each message over UDP
 	// to survive packet loss (receivers must treat repeats as retransmissions)
 	static constexpr int MOTOR_SEND_REPEATS = 3;
 	static constexpr int MOTOR_REPEAT_DELAY_MS = 10;
 
+	// Acknowledged motor mode ("motorAck" in the config): instead of blind
+	// repeats, each motor message carries a trailing int32 sequence number and
+	// is retransmitted until the device answers "/ack <sequence>" on
+	// replyPort (see OSCEgressService::sendAcknowledged)
+	bool isMotorAckEnabled() const { return motorAckEnabled; }
+	bool isMotorAckConfigured() const { return motorAckConfigured; } // even if the reply port failed
+	int getMotorAckReplyPort() const { return motorAckReplyPort; }
+	void setMotorAck(bool enable, int replyPort = DEFAULT_MOTOR_ACK_PORT);
+	static constexpr int DEFAULT_MOTOR_ACK_PORT = 9100;
+
 private:
 	bool enabled;
+	bool motorAckEnabled = false;
+	bool motorAckConfigured = false;
+	int motorAckReplyPort = DEFAULT_MOTOR_ACK_PORT;
+	std::string motorTargets;
 	std::vector<OSCDestination> destinations;
-	std::map<std::string, std::unique_ptr<ofxOscSender>> senders;
+	std::map<std::string, std::shared_ptr<OSCEgressService::Endpoint>> endpoints; // by destination name
 	std::atomic<int> sentMessageCount;
+	std::atomic<int> sentPacketCount;
+	int coalescedMessageCount = 0;
+	int deferredSendCount = 0;
+
+	// Pre-encoded per-position messages; sends patch the argument bytes in place
+	struct PositionTemplates {
+		OSCMessageTemplate rgb; // /rgb/<position> rgba originDeg arcDeg
+		OSCMessageTemplate power; // /pwr/<position> pwm
+		OSCMessageTemplate magnet; // /mag/<position> pwm
+	};
+	std::map<std::string, PositionTemplates, std::less<>> positionTemplates;
+	PositionTemplates & templatesFor(const std::string & position);
+
+	// Messages for this tick, in send order, each already framed as a bundle
+	// element (4-byte big-endian size, then the message). Cleared, not freed,
+	// after every flush so steady-state ticks do not allocate.
+	std::vector<char> frameBytes;
+	size_t frameMessageCount = 0;
+	void queueFrameMessage(const OSCMessageTemplate & message);
+	void sendPacketToUnlimited(const char * data, size_t size);
+
+	// Latest unsent LED message per address, for one rate-limited destination
+	struct HeldMessage {
+		std::array<char, OSCMessageTemplate::MAX_SIZE> bytes;
+		size_t size;
+		std::string_view getAddress() const { return std::string_view(bytes.data()); }
+	};
+	std::map<std::string, std::vector<HeldMessage>> heldMessages; // by destination name
+	size_t holdFrame(std::vector<HeldMessage> & held); // returns updates coalesced
+	void dropHeld(const std::string & destinationName);
+	void sendHeld(std::vector<HeldMessage> & held, const std::shared_ptr<OSCEgressService::Endpoint> & endpoint, double now);
 
 	// Internal helpers
 	void ensureSenderExists(const OSCDestination & dest);
+	// Drop a destination's endpoint and its rate limit registration
+	void releaseEndpoint(const std::string & destinationName);
+	void releaseEndpoints();
 	void sendMessageToAll(const ofxOscMessage & message);
 	void sendMessageToDestination(const ofxOscMessage & message, const OSCDestination & dest);
 
 	// Repeated sends: first goes out immediately on the caller thread, the
-	// remaining ones are timed precisely by a small worker thread so the
-	// frame loop never blocks on the inter-send delay.
-	struct PendingRepeat {
-		ofxOscMessage message;
-		int remaining = 0;
-		std::chrono::steady_clock::time_point nextDue;
-	};
-	std::thread repeatThread;
-	std::mutex repeatMutex;
-	std::condition_variable repeatCv;
-	std::deque<PendingRepeat> repeatQueue;
-	bool repeatThreadRunning = false; // guarded by repeatMutex
+	// remaining ones are timed by the shared egress I/O thread so the frame
+	// loop never blocks on the inter-send delay.
 	void sendMessageToAllRepeated(const ofxOscMessage & message, int totalSends);
-	void repeatWorker();
+
+	// Motor commands: acknowledged when motorAck is on, repeated otherwise
+	void sendMotorMessage(const ofxOscMessage & message);
 
 	// Message creation helpers
 	std::string buildMotorAddress(const std::string & command, int deviceId = -1);
@@ -106,7 +203,7 @@ private:
 
 	// JSON helpers
 	void loadDestinationsFromJson(const ofJson & json);
-	ofJson destinationsToJson() const;
+	void loadMotorAckFromJson(const ofJson & json);
 
 	// Validation
 	bool validateDeviceId(int deviceId) const;
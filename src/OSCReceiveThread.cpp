@@ -0,0 +1,67 @@
+#include "OSCReceiveThread.h"
+#include "ofMain.h"
+#include <chrono>
+#include <cstring>
+
+OSCReceiveThread::~OSCReceiveThread() {
+	stop();
+}
+
+uint64_t OSCReceiveThread::nowMicros() {
+	auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count());
+}
+
+bool OSCReceiveThread::start(int receivePort) {
+	stop();
+	port = receivePort;
+
+	try {
+		socket.reset(new osc::UdpListeningReceiveSocket(
+			osc::IpEndpointName(osc::IpEndpointName::ANY_ADDRESS, port), this, false));
+	} catch (const std::exception & e) {
+		ofLogError("OSCReceiveThread") << "Cannot listen on port " << port << ": " << e.what();
+		socket.reset();
+		return false;
+	}
+
+	running = true;
+	thread = std::thread([this] {
+		try {
+			socket->Run();
+		} catch (const std::exception & e) {
+			ofLogError("OSCReceiveThread") << "Receive loop stopped: " << e.what();
+		}
+	});
+	return true;
+}
+
+void OSCReceiveThread::stop() {
+	if (!running) return;
+	running = false;
+	if (socket) socket->AsynchronousBreak();
+	if (thread.joinable()) thread.join();
+	socket.reset();
+}
+
+void OSCReceiveThread::ProcessPacket(const char * data, int size, const osc::IpEndpointName & remoteEndpoint) {
+	receivedCount.fetch_add(1, std::memory_order_relaxed);
+
+	if (size <= 0 || static_cast<std::size_t>(size) > OSCPacket::MAX_SIZE) {
+		oversizedCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	OSCPacket * packet = queue.beginPush();
+	if (!packet) {
+		droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	packet->arrivalMicros = nowMicros();
+	packet->remoteAddress = static_cast<uint32_t>(remoteEndpoint.address);
+	packet->remotePort = remoteEndpoint.port;
+	packet->size = static_cast<uint32_t>(size);
+	std::memcpy(packet->data, data, static_cast<std::size_t>(size));
+	queue.endPush();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "PacketListener.h"
+#include "SPSCQueue.h"
+#include "UdpSocket.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+// One received UDP datagram, stamped on arrival (steady clock, microseconds)
+struct OSCPacket {
+	static constexpr std::size_t MAX_SIZE = 4080;
+
+	uint64_t arrivalMicros = 0;
+	uint32_t remoteAddress = 0;
+	int remotePort = 0;
+	uint32_t size = 0;
+	char data[MAX_SIZE];
+};
+
+// Dedicated OSC socket thread. Every datagram is timestamped and copied into a
+// bounded SPSC ring the frame loop drains, so long frames (XML saves,
+// sequencer loads) never leave packets sitting in the kernel socket buffer.
+class OSCReceiveThread : public osc::PacketListener {
+public:
+	static constexpr std::size_t QUEUE_CAPACITY = 512;
+	using Queue = SPSCQueue<OSCPacket, QUEUE_CAPACITY>;
+
+	OSCReceiveThread() = default;
+	~OSCReceiveThread();
+
+	bool start(int port);
+	void stop();
+	bool isRunning() const { return running; }
+	int getPort() const { return port; }
+
+	// Consumer side (frame thread only)
+	Queue & getQueue() { return queue; }
+
+	// Counters are written by the socket thread, read from anywhere
+	uint64_t getReceivedCount() const { return receivedCount.load(std::memory_order_relaxed); }
+	uint64_t getDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+	uint64_t getOversizedCount() const { return oversizedCount.load(std::memory_order_relaxed); }
+
+	static uint64_t nowMicros();
+
+	// osc::PacketListener (socket thread)
+	void ProcessPacket(const char * data, int size, const osc::IpEndpointName & remoteEndpoint) override;
+
+private:
+	Queue queue;
+	std::unique_ptr<osc::UdpListeningReceiveSocket> socket;
+	std::thread thread;
+	bool running = false;
+	int port = 0;
+
+	std::atomic<uint64_t> receivedCount { 0 };
+	std::atomic<uint64_t> droppedCount { 0 }; // ring full
+	std::atomic<uint64_t> oversizedCount { 0 }; // larger than OSCPacket::MAX_SIZE
+};
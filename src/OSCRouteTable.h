@@ -0,0 +1,101 @@
+#pragma once
+
+#include "OSCAddress.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Segment trie mapping OSC address patterns to handlers, built once at startup.
+// Pattern segments are literals, "*" (exactly one segment, e.g. a hourglass id)
+// or a trailing "**" (zero or more remaining segments). Lookup prefers literals
+// over "*" over "**" and backtracks, so it never allocates.
+template <typename Handler>
+class OSCRouteTable {
+public:
+	OSCRouteTable() { nodes.emplace_back(); }
+
+	// e.g. add("/hourglass/*/motor/**", handler); a later add of the same pattern replaces it
+	void add(std::string_view pattern, Handler handler) {
+		OSCAddress segments(pattern);
+		int node = 0;
+		for (std::size_t i = 0; i < segments.size(); i++) {
+			std::string_view segment = segments[i];
+			if (segment == "**") {
+				node = childFor(node, &Node::rest);
+				break;
+			}
+			node = segment == "*" ? childFor(node, &Node::wildcard) : literalChild(node, segment);
+		}
+		if (nodes[node].handler < 0) {
+			nodes[node].handler = static_cast<int>(handlers.size());
+			handlers.push_back(handler);
+		} else {
+			handlers[nodes[node].handler] = handler;
+		}
+	}
+
+	// Handler for the address, or nullptr when no route matches
+	const Handler * find(const OSCAddress & address) const {
+		int handler = match(0, address, 0);
+		return handler < 0 ? nullptr : &handlers[handler];
+	}
+
+	std::size_t size() const { return handlers.size(); }
+
+private:
+	struct Node {
+		std::string segment;
+		std::vector<int> literals;
+		int wildcard = -1; // "*"
+		int rest = -1; // "**"
+		int handler = -1;
+	};
+
+	std::vector<Node> nodes;
+	std::vector<Handler> handlers;
+
+	// The "*" or "**" child of node, created on first use. Indexes nodes again
+	// after emplace_back(), which may reallocate.
+	int childFor(int node, int Node::*field) {
+		int child = nodes[node].*field;
+		if (child < 0) {
+			child = static_cast<int>(nodes.size());
+			nodes.emplace_back();
+			nodes[node].*field = child;
+		}
+		return child;
+	}
+
+	int literalChild(int node, std::string_view segment) {
+		for (int child : nodes[node].literals) {
+			if (nodes[child].segment == segment) return child;
+		}
+		int child = static_cast<int>(nodes.size());
+		nodes.emplace_back();
+		nodes[child].segment = std::string(segment);
+		nodes[node].literals.push_back(child);
+		return child;
+	}
+
+	int match(int node, const OSCAddress & address, std::size_t depth) const {
+		const Node & n = nodes[node];
+		if (depth == address.size()) {
+			if (n.handler >= 0) return n.handler;
+			return n.rest >= 0 ? nodes[n.rest].handler : -1;
+		}
+
+		std::string_view segment = address[depth];
+		for (int child : n.literals) {
+			if (nodes[child].segment == segment) {
+				int handler = match(child, address, depth + 1);
+				if (handler >= 0) return handler;
+				break;
+			}
+		}
+		if (n.wildcard >= 0) {
+			int handler = match(n.wildcard, address, depth + 1);
+			if (handler >= 0) return handler;
+		}
+		return n.rest >= 0 ? nodes[n.rest].handler : -1;
+	}
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Min-heap of repeating sends: O(log n) insert and pop of the earliest entry,
+// instead of scanning every pending entry on each wake. Entries due at the
+// same time fire in insertion order. Each firing is rescheduled from its
+// previous due time, so small wake-up lateness does not accumulate into the
+// cadence; an entry that fell a whole interval behind restarts from now to
+// keep the spacing between its sends.
+template <typename Payload>
+class RepeatScheduler {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	// Fire payload `count` times, `interval` apart, the first at firstDue
+	void push(Payload payload, int count, Clock::duration interval, Clock::time_point firstDue) {
+		if (count <= 0) return;
+		heap.push_back(Entry { firstDue, nextSequence++, interval, count, std::move(payload) });
+		std::push_heap(heap.begin(), heap.end(), Later());
+	}
+
+	bool empty() const { return heap.empty(); }
+	std::size_t size() const { return heap.size(); }
+	Clock::time_point nextDue() const { return heap.front().due; }
+
+	// Calls fire(payload, scheduledDue) for every entry due by now + horizon,
+	// earliest first; returns the number of firings. A small horizon lets one
+	// wake-up serve entries queued microseconds apart instead of sleeping
+	// (and paying the timer's wake-up latency) once per entry.
+	template <typename Fn>
+	std::size_t runDue(Clock::time_point now, Clock::duration horizon, Fn && fire) {
+		std::size_t fired = 0;
+		while (!heap.empty() && heap.front().due <= now + horizon) {
+			std::pop_heap(heap.begin(), heap.end(), Later());
+			Entry & entry = heap.back();
+			fire(entry.payload, entry.due);
+			fired++;
+
+			if (--entry.remaining <= 0) {
+				heap.pop_back();
+				continue;
+			}
+			entry.due += entry.interval;
+			if (entry.due <= now) entry.due = now + entry.interval;
+			entry.sequence = nextSequence++;
+			std::push_heap(heap.begin(), heap.end(), Later());
+		}
+		return fired;
+	}
+
+	void clear() { heap.clear(); }
+
+private:
+	struct Entry {
+		Clock::time_point due;
+		uint64_t sequence;
+		Clock::duration interval;
+		int remaining;
+		Payload payload;
+	};
+	struct Later {
+		bool operator()(const Entry & a, const Entry & b) const {
+			return a.due != b.due ? a.due > b.due : a.sequence > b.sequence;
+		}
+	};
+	std::vector<Entry> heap;
+	uint64_t nextSequence = 0;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free single-producer/single-consumer ring.
+// Slots are written and read in place (beginPush/endPush, front/pop) so large
+// payloads such as datagrams are never copied through the queue. Exactly one
+// thread may push and exactly one other thread may pop.
+template <typename T, std::size_t Capacity>
+class SPSCQueue {
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	// Producer: slot to fill, or nullptr when the ring is full
+	T * beginPush() {
+		const std::size_t head = headIndex.load(std::memory_order_relaxed);
+		if (head - tailIndex.load(std::memory_order_acquire) >= Capacity) return nullptr;
+		return &slots[head & (Capacity - 1)];
+	}
+
+	// Producer: publish the slot returned by beginPush()
+	void endPush() {
+		headIndex.store(headIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	// Consumer: oldest slot, or nullptr when empty
+	T * front() {
+		const std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+		if (tail == headIndex.load(std::memory_order_acquire)) return nullptr;
+		return &slots[tail & (Capacity - 1)];
+	}
+
+	// Consumer: release the slot returned by front()
+	void pop() {
+		tailIndex.store(tailIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	std::size_t size() const {
+		return headIndex.load(std::memory_order_acquire) - tailIndex.load(std::memory_order_acquire);
+	}
+	static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+	std::array<T, Capacity> slots {};
+	alignas(64) std::atomic<std::size_t> headIndex { 0 };
+	alignas(64) std::atomic<std::size_t> tailIndex { 0 };
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+
+// Classic token bucket: refills at `rate` tokens per second up to `capacity`.
+// A rate of 0 means unlimited. Not thread-safe; times are in seconds from any
+// monotonic clock.
+class TokenBucket {
+public:
+	// A bucket that was unlimited starts full; otherwise the tokens carry over
+	// (capped at the new capacity), so reconfiguring never grants a fresh burst
+	void configure(double ratePerSecond, double burstCapacity) {
+		bool wasLimited = isLimited();
+		rate = std::max(0.0, ratePerSecond);
+		capacity = std::max(0.0, burstCapacity);
+		tokens = wasLimited ? std::min(tokens, capacity) : capacity;
+	}
+
+	bool isLimited() const { return rate > 0.0; }
+	double getRate() const { return rate; }
+
+	void refill(double now) {
+		if (!started) {
+			lastRefill = now;
+			started = true;
+			return;
+		}
+		tokens = std::min(capacity, tokens + (now - lastRefill) * rate);
+		lastRefill = now;
+	}
+
+	bool canConsume(double amount) const { return !isLimited() || tokens >= amount; }
+	void consume(double amount) {
+		if (isLimited()) tokens -= amount;
+	}
+
+private:
+	double rate = 0.0;
+	double capacity = 0.0;
+	double tokens = 0.0;
+	double lastRefill = 0.0;
+	bool started = false;
+};
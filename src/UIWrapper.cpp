@@ -1,6 +1,7 @@
 #include "UIWrapper.h"
 #include "ArcCosineEffect.h"
 #include "OSCController.h"
+#include "OSCEgressService.h"
 #include "ofMain.h"
 
 // OSC activity tracking constants
@@ -423,6 +424,56 @@ void UIWrapper::drawStatusBar() {
 	rx -= 14 + (statusFont.isLoaded() ? statusFont.stringWidth("OSC") : 24.0f);
 	ofSetColor(kMuted);
 	drawChromeText(statusFont, "OSC", rx, textY);
+
+	updateEgressStatus();
+	if (!egressStatusText.empty()) {
+		rx -= 24 + (statusFont.isLoaded() ? statusFont.stringWidth(egressStatusText) : egressStatusText.size() * 8.0f);
+		ofSetColor(egressStatusErrors > 0 ? kDanger : kMuted);
+		drawChromeText(statusFont, egressStatusText, rx, textY);
+	}
+}
+
+// "OUT 240 pkt/s 31.2 KB/s · max 10.0.0.12:9000 · 2 ERR", summed over egress endpoints,
+// then "BUNDLES late max 1.2 ms" once timetagged bundles have been applied
+void UIWrapper::updateEgressStatus() {
+	float now = ofGetElapsedTimef();
+	if (now - egressStatusTime < OSCEgressService::STATS_RATE_INTERVAL) return;
+	egressStatusTime = now;
+
+	std::string bundleText;
+	if (oscControllerInstance) {
+		const OSCBundleScheduler::Stats & bundles = oscControllerInstance->getBundleScheduler().getStats();
+		if (bundles.applied > 0) {
+			bundleText = "BUNDLES late max " + ofToString(bundles.maxLatenessMicros / 1000.0, 1) + " ms";
+		}
+	}
+
+	auto endpoints = OSCEgressService::instance().getEndpoints();
+	if (endpoints.empty()) {
+		egressStatusText = bundleText;
+		egressStatusErrors = 0;
+		return;
+	}
+	float packetsPerSecond = 0.0f;
+	float bytesPerSecond = 0.0f;
+	float busiestBytes = -1.0f;
+	std::string busiest;
+	uint64_t errors = 0;
+	for (const auto & endpoint : endpoints) {
+		OSCEgressService::Endpoint::Stats stats = endpoint->getStats();
+		packetsPerSecond += stats.packetsPerSecond;
+		bytesPerSecond += stats.bytesPerSecond;
+		errors += stats.errors;
+		if (stats.bytesPerSecond > busiestBytes) {
+			busiestBytes = stats.bytesPerSecond;
+			busiest = endpoint->getHost() + ":" + ofToString(endpoint->getPort());
+		}
+	}
+	egressStatusText = "OUT " + ofToString(packetsPerSecond, 0) + " pkt/s " + ofToString(bytesPerSecond / 1024.0f, 1) + " KB/s";
+	if (endpoints.size() > 1) egressStatusText += " · max " + busiest;
+	if (errors > 0) egressStatusText += " · " + ofToString(errors) + " ERR";
+	if (!bundleText.empty()) egressStatusText += " · " + bundleText;
+	egressStatusErrors = errors;
 }
 
 void UIWrapper::drawEStop() {
@@ -809,7 +860,7 @@ void UIWrapper::onAllOffPressed() {
 		// Set flag to prevent feedback
 		isUpdatingFromEffects = true;
 
-		// Use safe parameter setting; applied by applyLedParameters() in the update loop
+		// Use safe parameter setting; applied by HourGlassManager::update() in the update loop
 		hg->upLedColor.set(ofColor::black);
 		hg->downLedColor.set(ofColor::black);
 		hg->upMainLed.set(0);
@@ -1281,15 +1332,11 @@ void UIWrapper::updateCurrentIndividualLuminositySlider(float luminosity) {
 
 void UIWrapper::onAddCosineArcEffectPressed() {
 	if (!hourglassManager) return;
-	HourGlass * hg = hourglassManager->getHourGlass(currentHourGlass);
-	if (hg) {
-		// Add to UP controller
-		auto upEffect = std::make_unique<ArcCosineEffect>(90.0f, 270.0f, 5.0f); // Example params
-		hg->addUpEffect(std::move(upEffect));
-
-		// Add to DOWN controller
-		auto downEffect = std::make_unique<ArcCosineEffect>(45.0f, 315.0f, 3.5f); // Example params
-		hg->addDownEffect(std::move(downEffect));
+	if (hourglassManager->getHourGlass(currentHourGlass)) {
+		EffectEngine & effects = hourglassManager->getEffectEngine();
+		// Example params
+		effects.add(HourGlassManager::ledSlot(currentHourGlass, true), ArcCosineEffect(90.0f, 270.0f, 5.0f));
+		effects.add(HourGlassManager::ledSlot(currentHourGlass, false), ArcCosineEffect(45.0f, 315.0f, 3.5f));
 	} else {
 		ofLogWarning("UIWrapper") << "No HourGlass selected to add effect to.";
 	}
@@ -1297,10 +1344,10 @@ void UIWrapper::onAddCosineArcEffectPressed() {
 
 void UIWrapper::onClearAllEffectsPressed() {
 	if (!hourglassManager) return;
-	HourGlass * hg = hourglassManager->getHourGlass(currentHourGlass);
-	if (hg) {
-		hg->clearUpEffects();
-		hg->clearDownEffects();
+	if (hourglassManager->getHourGlass(currentHourGlass)) {
+		EffectEngine & effects = hourglassManager->getEffectEngine();
+		effects.clearSlot(HourGlassManager::ledSlot(currentHourGlass, true));
+		effects.clearSlot(HourGlassManager::ledSlot(currentHourGlass, false));
 	} else {
 		ofLogWarning("UIWrapper") << "No HourGlass selected to clear effects from.";
 	}
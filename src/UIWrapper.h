@@ -171,6 +171,12 @@ private:
 	ofTrueTypeFont statusFont; // real TTF for custom-drawn chrome (ofxGui has its own)
 	ofTrueTypeFont estopFont;
 
+	// Egress summary in the status bar, rebuilt once per second
+	std::string egressStatusText;
+	uint64_t egressStatusErrors = 0;
+	float egressStatusTime = -10.0f;
+	void updateEgressStatus();
+
 	// Keyboard command handlers
 	void handleHourGlassSelection(int key);
 	void handleConnectionCommands(int key);
@@ -1,6 +1,9 @@
 #include "ofApp.h"
 #include "ofMain.h"
 
+// The headless target (headless/) provides its own main()
+#ifndef MYRIADES_HEADLESS
+
 //========================================================================
 int main() {
 
@@ -21,3 +24,4 @@ int main() {
 	ofRunApp(window, std::make_shared<ofApp>());
 	ofRunMainLoop();
 }
+#endif
@@ -61,8 +61,14 @@ void ofApp::update() {
 	// Advance sequencer playback (before the hardware tick in ui.update())
 	vezerPlayer.update(ofGetLastFrameTime());
 
+	// Apply the LED values staged by this frame's OSC and sequencer messages
+	oscController.commitStagedParameters();
+
 	// Update UI
 	ui.update();
+
+	// Send the LED datagrams every hourglass queued this tick
+	OSCEgressService::instance().flushPackets();
 }
 
 //--------------------------------------------------------------
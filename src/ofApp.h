@@ -1,6 +1,7 @@
 #pragma once
 
 #include "HourGlassManager.h"
+#include "OSCEgressService.h"
 #include "OSCController.h"
 #include "UIWrapper.h"
 #include "VezerPlayer.h"